@@ -0,0 +1,1591 @@
+/*
+* Copyright 2021 NVIDIA Corporation.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*    http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/*
+ * Mock Vulkan Video driver.
+ *
+ * The driver exposes one physical device with a graphics queue family and an H.264/H.265
+ * video decode queue family, host visible memory and a single direct-to-display output.
+ * Submitted work completes immediately: the fences are signaled at submission time, the
+ * video decode queries report VK_QUERY_RESULT_STATUS_COMPLETE_KHR and the images are never
+ * written. This lets vk-video-dec-test run without a video capable GPU, for example to train
+ * the PGO builds of the decoder (see scripts/build_pgo.sh), by pointing the Vulkan loader at
+ * the VkVideoMockIcd.json manifest of the build with VK_ICD_FILENAMES.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "vulkan_interfaces.h"
+
+// Loader <-> ICD interface, see vk_icd.h of the Vulkan-Loader
+#define ICD_LOADER_MAGIC 0x01CDC0DE
+#define MOCK_ICD_LOADER_INTERFACE_VERSION 5
+#define MOCK_ICD_EXPORT extern "C" __attribute__((visibility("default")))
+
+namespace {
+
+const uint32_t kApiVersion = VK_MAKE_API_VERSION(0, 1, 2, 178);
+const uint32_t kGraphicsQueueFamily = 0;
+const uint32_t kVideoDecodeQueueFamily = 1;
+const uint32_t kQueueFamilyCount = 2;
+const uint32_t kMaxQueueCount = 16;
+const VkDeviceSize kAlignment = 256;
+const VkExtent2D kDisplayResolution = { 1920, 1080 };
+
+// The loader stores its dispatch table pointer in the first word of every dispatchable object
+struct MockPhysicalDevice {
+    uintptr_t loaderMagic;
+};
+
+struct MockInstance {
+    uintptr_t loaderMagic;
+    MockPhysicalDevice physicalDevice;
+    VkDisplayKHR display;
+    VkDisplayModeKHR displayMode;
+};
+
+struct MockQueue {
+    uintptr_t loaderMagic;
+};
+
+struct MockDevice {
+    uintptr_t loaderMagic;
+    MockQueue queues[kQueueFamilyCount][kMaxQueueCount];
+};
+
+struct MockCommandBuffer {
+    uintptr_t loaderMagic;
+};
+
+struct MockCommandPool {
+    std::vector<MockCommandBuffer*> commandBuffers;
+};
+
+struct MockFence {
+    std::atomic<bool> signaled;
+};
+
+struct MockDeviceMemory {
+    VkDeviceSize size;
+    void* data;
+};
+
+struct MockBuffer {
+    VkDeviceSize size;
+};
+
+struct MockImage {
+    VkFormat format;
+    VkExtent3D extent;
+    uint32_t planes;
+    VkDeviceSize rowPitch;
+    VkDeviceSize planeSize;
+};
+
+struct MockSurface {
+    VkExtent2D currentExtent;
+};
+
+struct MockSwapchain {
+    std::vector<MockImage*> images;
+    uint32_t nextImage;
+};
+
+std::atomic<uint64_t> nextHandle(1);
+
+// Handle of an object without driver side state
+template <typename Handle>
+Handle NewHandle()
+{
+    return (Handle)(uintptr_t)nextHandle++;
+}
+
+template <typename Handle, typename Object>
+Handle ToHandle(Object* pObject)
+{
+    return (Handle)(uintptr_t)pObject;
+}
+
+template <typename Object, typename Handle>
+Object* FromHandle(Handle handle)
+{
+    return (Object*)(uintptr_t)handle;
+}
+
+VkDeviceSize AlignUp(VkDeviceSize size, VkDeviceSize alignment)
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+// Returns VK_INCOMPLETE when pProperties is too small, per the Vulkan enumeration rules
+template <typename T>
+VkResult EnumerateArray(const T* pSource, uint32_t sourceCount, uint32_t* pCount, T* pProperties)
+{
+    if (pProperties == NULL) {
+        *pCount = sourceCount;
+        return VK_SUCCESS;
+    }
+    const uint32_t count = std::min(*pCount, sourceCount);
+    std::copy(pSource, pSource + count, pProperties);
+    *pCount = count;
+    return (count < sourceCount) ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+const VkExtensionProperties instanceExtensions[] = {
+    { VK_KHR_SURFACE_EXTENSION_NAME, VK_KHR_SURFACE_SPEC_VERSION },
+    { VK_KHR_DISPLAY_EXTENSION_NAME, VK_KHR_DISPLAY_SPEC_VERSION },
+    { VK_EXT_DIRECT_MODE_DISPLAY_EXTENSION_NAME, VK_EXT_DIRECT_MODE_DISPLAY_SPEC_VERSION },
+    // Required by ShellDirect. There is no X display to acquire, so vkAcquireXlibDisplayEXT is not exposed.
+    { "VK_EXT_acquire_xlib_display", 1 },
+    { VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_SPEC_VERSION },
+#ifdef VK_USE_PLATFORM_XCB_KHR
+    { VK_KHR_XCB_SURFACE_EXTENSION_NAME, VK_KHR_XCB_SURFACE_SPEC_VERSION },
+#endif
+};
+
+const VkExtensionProperties deviceExtensions[] = {
+    { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_KHR_SWAPCHAIN_SPEC_VERSION },
+    { VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME, VK_KHR_EXTERNAL_MEMORY_SPEC_VERSION },
+    { VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME, VK_KHR_EXTERNAL_MEMORY_FD_SPEC_VERSION },
+    { VK_KHR_EXTERNAL_FENCE_EXTENSION_NAME, VK_KHR_EXTERNAL_FENCE_SPEC_VERSION },
+    { VK_KHR_EXTERNAL_FENCE_FD_EXTENSION_NAME, VK_KHR_EXTERNAL_FENCE_FD_SPEC_VERSION },
+    { VK_EXT_DISPLAY_CONTROL_EXTENSION_NAME, VK_EXT_DISPLAY_CONTROL_SPEC_VERSION },
+    { VK_KHR_SAMPLER_YCBCR_CONVERSION_EXTENSION_NAME, VK_KHR_SAMPLER_YCBCR_CONVERSION_SPEC_VERSION },
+    { VK_EXT_YCBCR_2PLANE_444_FORMATS_EXTENSION_NAME, VK_EXT_YCBCR_2PLANE_444_FORMATS_SPEC_VERSION },
+    { VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME, VK_KHR_SYNCHRONIZATION_2_SPEC_VERSION },
+    { VK_KHR_VIDEO_QUEUE_EXTENSION_NAME, VK_KHR_VIDEO_QUEUE_SPEC_VERSION },
+    { VK_KHR_VIDEO_DECODE_QUEUE_EXTENSION_NAME, VK_KHR_VIDEO_DECODE_QUEUE_SPEC_VERSION },
+    { VK_EXT_VIDEO_DECODE_H264_EXTENSION_NAME, VK_EXT_VIDEO_DECODE_H264_SPEC_VERSION },
+    { VK_EXT_VIDEO_DECODE_H265_EXTENSION_NAME, VK_EXT_VIDEO_DECODE_H265_SPEC_VERSION },
+};
+
+uint32_t GetPlaneCount(VkFormat format)
+{
+    switch ((int32_t)format) {
+    case VK_FORMAT_G8_B8R8_2PLANE_420_UNORM:
+    case VK_FORMAT_G8_B8R8_2PLANE_422_UNORM:
+    case VK_FORMAT_G8_B8R8_2PLANE_444_UNORM_EXT:
+    case VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16:
+    case VK_FORMAT_G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16:
+    case VK_FORMAT_G10X6_B10X6R10X6_2PLANE_444_UNORM_3PACK16_EXT:
+    case VK_FORMAT_G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16:
+    case VK_FORMAT_G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16:
+    case VK_FORMAT_G12X4_B12X4R12X4_2PLANE_444_UNORM_3PACK16_EXT:
+    case VK_FORMAT_G16_B16R16_2PLANE_420_UNORM:
+    case VK_FORMAT_G16_B16R16_2PLANE_422_UNORM:
+    case VK_FORMAT_G16_B16R16_2PLANE_444_UNORM_EXT:
+        return 2;
+    case VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM:
+    case VK_FORMAT_G8_B8_R8_3PLANE_422_UNORM:
+    case VK_FORMAT_G8_B8_R8_3PLANE_444_UNORM:
+    case VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16:
+    case VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16:
+    case VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16:
+    case VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16:
+    case VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16:
+    case VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16:
+    case VK_FORMAT_G16_B16_R16_3PLANE_420_UNORM:
+    case VK_FORMAT_G16_B16_R16_3PLANE_422_UNORM:
+    case VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM:
+        return 3;
+    default:
+        return 1;
+    }
+}
+
+MockImage* NewImage(VkFormat format, VkExtent3D extent)
+{
+    MockImage* pImage = new MockImage();
+    pImage->format = format;
+    pImage->extent = extent;
+    pImage->planes = GetPlaneCount(format);
+    // Every plane gets up to 4 bytes per luma sample, enough for the 16 bit 4:4:4 chroma planes
+    pImage->rowPitch = AlignUp((VkDeviceSize)extent.width * 4, kAlignment);
+    pImage->planeSize = pImage->rowPitch * extent.height;
+    return pImage;
+}
+
+void SignalFence(VkFence fence)
+{
+    if (fence != VK_NULL_HANDLE) {
+        FromHandle<MockFence>(fence)->signaled = true;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Instance and physical device
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateInstance(const VkInstanceCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator,
+                                              VkInstance* pInstance)
+{
+    MockInstance* pMockInstance = new MockInstance();
+    pMockInstance->loaderMagic = ICD_LOADER_MAGIC;
+    pMockInstance->physicalDevice.loaderMagic = ICD_LOADER_MAGIC;
+    pMockInstance->display = NewHandle<VkDisplayKHR>();
+    pMockInstance->displayMode = NewHandle<VkDisplayModeKHR>();
+    *pInstance = reinterpret_cast<VkInstance>(pMockInstance);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocationCallbacks* pAllocator)
+{
+    delete reinterpret_cast<MockInstance*>(instance);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL EnumerateInstanceExtensionProperties(const char* pLayerName, uint32_t* pPropertyCount,
+                                                                    VkExtensionProperties* pProperties)
+{
+    if (pLayerName != NULL) {
+        return VK_ERROR_LAYER_NOT_PRESENT;
+    }
+    return EnumerateArray(instanceExtensions, sizeof(instanceExtensions) / sizeof(instanceExtensions[0]), pPropertyCount, pProperties);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL EnumerateInstanceVersion(uint32_t* pApiVersion)
+{
+    *pApiVersion = kApiVersion;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL EnumeratePhysicalDevices(VkInstance instance, uint32_t* pPhysicalDeviceCount,
+                                                        VkPhysicalDevice* pPhysicalDevices)
+{
+    const VkPhysicalDevice physicalDevice = reinterpret_cast<VkPhysicalDevice>(&reinterpret_cast<MockInstance*>(instance)->physicalDevice);
+    return EnumerateArray(&physicalDevice, 1, pPhysicalDeviceCount, pPhysicalDevices);
+}
+
+VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceProperties(VkPhysicalDevice physicalDevice, VkPhysicalDeviceProperties* pProperties)
+{
+    memset(pProperties, 0, sizeof(*pProperties));
+    pProperties->apiVersion = kApiVersion;
+    pProperties->driverVersion = 1;
+    pProperties->vendorID = 0xFFFF;
+    pProperties->deviceID = 0xFFFF;
+    pProperties->deviceType = VK_PHYSICAL_DEVICE_TYPE_CPU;
+    strncpy(pProperties->deviceName, "Vulkan Video Mock Device", sizeof(pProperties->deviceName) - 1);
+
+    VkPhysicalDeviceLimits& limits = pProperties->limits;
+    limits.maxImageDimension1D = 16384;
+    limits.maxImageDimension2D = 16384;
+    limits.maxImageDimension3D = 2048;
+    limits.maxImageDimensionCube = 16384;
+    limits.maxImageArrayLayers = 2048;
+    limits.maxTexelBufferElements = 128 * 1024 * 1024;
+    limits.maxUniformBufferRange = 64 * 1024;
+    limits.maxStorageBufferRange = 0x7FFFFFFF;
+    limits.maxPushConstantsSize = 256;
+    limits.maxMemoryAllocationCount = 4096;
+    limits.maxSamplerAllocationCount = 4000;
+    limits.bufferImageGranularity = 1;
+    limits.maxBoundDescriptorSets = 8;
+    limits.maxPerStageDescriptorSamplers = 16;
+    limits.maxPerStageDescriptorUniformBuffers = 12;
+    limits.maxPerStageDescriptorStorageBuffers = 16;
+    limits.maxPerStageDescriptorSampledImages = 16;
+    limits.maxPerStageDescriptorStorageImages = 8;
+    limits.maxPerStageResources = 128;
+    limits.maxDescriptorSetSamplers = 96;
+    limits.maxDescriptorSetUniformBuffers = 72;
+    limits.maxDescriptorSetUniformBuffersDynamic = 8;
+    limits.maxDescriptorSetStorageBuffers = 96;
+    limits.maxDescriptorSetStorageBuffersDynamic = 8;
+    limits.maxDescriptorSetSampledImages = 96;
+    limits.maxDescriptorSetStorageImages = 48;
+    limits.maxVertexInputAttributes = 16;
+    limits.maxVertexInputBindings = 16;
+    limits.maxVertexInputAttributeOffset = 2047;
+    limits.maxVertexInputBindingStride = 2048;
+    limits.maxVertexOutputComponents = 64;
+    limits.maxFragmentInputComponents = 64;
+    limits.maxFragmentOutputAttachments = 4;
+    limits.maxFragmentCombinedOutputResources = 4;
+    limits.maxComputeSharedMemorySize = 16384;
+    limits.maxComputeWorkGroupCount[0] = limits.maxComputeWorkGroupCount[1] = limits.maxComputeWorkGroupCount[2] = 65535;
+    limits.maxComputeWorkGroupInvocations = 128;
+    limits.maxComputeWorkGroupSize[0] = limits.maxComputeWorkGroupSize[1] = 128;
+    limits.maxComputeWorkGroupSize[2] = 64;
+    limits.maxDrawIndexedIndexValue = 0xFFFFFFFF;
+    limits.maxDrawIndirectCount = 0xFFFFFFFF;
+    limits.maxSamplerLodBias = 2.0f;
+    limits.maxSamplerAnisotropy = 16.0f;
+    limits.maxViewports = 1;
+    limits.maxViewportDimensions[0] = limits.maxViewportDimensions[1] = 16384;
+    limits.viewportBoundsRange[0] = -32768.0f;
+    limits.viewportBoundsRange[1] = 32767.0f;
+    limits.minMemoryMapAlignment = 64;
+    limits.minTexelBufferOffsetAlignment = kAlignment;
+    limits.minUniformBufferOffsetAlignment = kAlignment;
+    limits.minStorageBufferOffsetAlignment = kAlignment;
+    limits.maxFramebufferWidth = 16384;
+    limits.maxFramebufferHeight = 16384;
+    limits.maxFramebufferLayers = 2048;
+    limits.framebufferColorSampleCounts = VK_SAMPLE_COUNT_1_BIT;
+    limits.framebufferDepthSampleCounts = VK_SAMPLE_COUNT_1_BIT;
+    limits.framebufferStencilSampleCounts = VK_SAMPLE_COUNT_1_BIT;
+    limits.framebufferNoAttachmentsSampleCounts = VK_SAMPLE_COUNT_1_BIT;
+    limits.maxColorAttachments = 4;
+    limits.sampledImageColorSampleCounts = VK_SAMPLE_COUNT_1_BIT;
+    limits.sampledImageIntegerSampleCounts = VK_SAMPLE_COUNT_1_BIT;
+    limits.sampledImageDepthSampleCounts = VK_SAMPLE_COUNT_1_BIT;
+    limits.sampledImageStencilSampleCounts = VK_SAMPLE_COUNT_1_BIT;
+    limits.storageImageSampleCounts = VK_SAMPLE_COUNT_1_BIT;
+    limits.maxSampleMaskWords = 1;
+    limits.timestampComputeAndGraphics = VK_TRUE;
+    limits.timestampPeriod = 1.0f;
+    limits.maxClipDistances = 8;
+    limits.maxCullDistances = 8;
+    limits.maxCombinedClipAndCullDistances = 8;
+    limits.discreteQueuePriorities = 2;
+    limits.pointSizeRange[0] = limits.pointSizeGranularity = limits.lineWidthRange[0] = limits.lineWidthGranularity = 1.0f;
+    limits.pointSizeRange[1] = limits.lineWidthRange[1] = 64.0f;
+    limits.optimalBufferCopyOffsetAlignment = kAlignment;
+    limits.optimalBufferCopyRowPitchAlignment = kAlignment;
+    limits.nonCoherentAtomSize = kAlignment;
+}
+
+VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceProperties2(VkPhysicalDevice physicalDevice, VkPhysicalDeviceProperties2* pProperties)
+{
+    GetPhysicalDeviceProperties(physicalDevice, &pProperties->properties);
+}
+
+VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFeatures(VkPhysicalDevice physicalDevice, VkPhysicalDeviceFeatures* pFeatures)
+{
+    memset(pFeatures, 0, sizeof(*pFeatures));
+    pFeatures->samplerAnisotropy = VK_TRUE;
+}
+
+VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFeatures2(VkPhysicalDevice physicalDevice, VkPhysicalDeviceFeatures2* pFeatures)
+{
+    GetPhysicalDeviceFeatures(physicalDevice, &pFeatures->features);
+    for (VkBaseOutStructure* pNext = (VkBaseOutStructure*)pFeatures->pNext; pNext; pNext = pNext->pNext) {
+        switch ((int32_t)pNext->sType) {
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SAMPLER_YCBCR_CONVERSION_FEATURES:
+            ((VkPhysicalDeviceSamplerYcbcrConversionFeatures*)pNext)->samplerYcbcrConversion = VK_TRUE;
+            break;
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR:
+            ((VkPhysicalDeviceSynchronization2FeaturesKHR*)pNext)->synchronization2 = VK_TRUE;
+            break;
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_YCBCR_2_PLANE_444_FORMATS_FEATURES_EXT:
+            ((VkPhysicalDeviceYcbcr2Plane444FormatsFeaturesEXT*)pNext)->ycbcr2plane444Formats = VK_TRUE;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFormatProperties(VkPhysicalDevice physicalDevice, VkFormat format,
+                                                             VkFormatProperties* pFormatProperties)
+{
+    // Linear images support the same features as the optimal ones, so the decoded pictures are never staged
+    const VkFormatFeatureFlags imageFeatures =
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT |
+        VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BLEND_BIT |
+        VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+        VK_FORMAT_FEATURE_TRANSFER_SRC_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT |
+        VK_FORMAT_FEATURE_MIDPOINT_CHROMA_SAMPLES_BIT | VK_FORMAT_FEATURE_COSITED_CHROMA_SAMPLES_BIT |
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_YCBCR_CONVERSION_LINEAR_FILTER_BIT;
+    pFormatProperties->linearTilingFeatures = imageFeatures;
+    pFormatProperties->optimalTilingFeatures = imageFeatures;
+    pFormatProperties->bufferFeatures = VK_FORMAT_FEATURE_VERTEX_BUFFER_BIT | VK_FORMAT_FEATURE_UNIFORM_TEXEL_BUFFER_BIT;
+}
+
+VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFormatProperties2(VkPhysicalDevice physicalDevice, VkFormat format,
+                                                              VkFormatProperties2* pFormatProperties)
+{
+    GetPhysicalDeviceFormatProperties(physicalDevice, format, &pFormatProperties->formatProperties);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceImageFormatProperties(VkPhysicalDevice physicalDevice, VkFormat format, VkImageType type,
+                                                                      VkImageTiling tiling, VkImageUsageFlags usage, VkImageCreateFlags flags,
+                                                                      VkImageFormatProperties* pImageFormatProperties)
+{
+    pImageFormatProperties->maxExtent = { 16384, 16384, (type == VK_IMAGE_TYPE_3D) ? 2048u : 1u };
+    pImageFormatProperties->maxMipLevels = 15;
+    pImageFormatProperties->maxArrayLayers = 2048;
+    pImageFormatProperties->sampleCounts = VK_SAMPLE_COUNT_1_BIT;
+    pImageFormatProperties->maxResourceSize = (VkDeviceSize)1 << 32;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceSparseImageFormatProperties(VkPhysicalDevice physicalDevice, VkFormat format, VkImageType type,
+                                                                        VkSampleCountFlagBits samples, VkImageUsageFlags usage,
+                                                                        VkImageTiling tiling, uint32_t* pPropertyCount,
+                                                                        VkSparseImageFormatProperties* pProperties)
+{
+    *pPropertyCount = 0;
+}
+
+VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMemoryProperties(VkPhysicalDevice physicalDevice,
+                                                             VkPhysicalDeviceMemoryProperties* pMemoryProperties)
+{
+    // A single heap of host memory, mapped on demand
+    memset(pMemoryProperties, 0, sizeof(*pMemoryProperties));
+    pMemoryProperties->memoryTypeCount = 1;
+    pMemoryProperties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                      VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+    pMemoryProperties->memoryTypes[0].heapIndex = 0;
+    pMemoryProperties->memoryHeapCount = 1;
+    pMemoryProperties->memoryHeaps[0].size = (VkDeviceSize)8 << 30;
+    pMemoryProperties->memoryHeaps[0].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+}
+
+VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMemoryProperties2(VkPhysicalDevice physicalDevice,
+                                                              VkPhysicalDeviceMemoryProperties2* pMemoryProperties)
+{
+    GetPhysicalDeviceMemoryProperties(physicalDevice, &pMemoryProperties->memoryProperties);
+}
+
+VkQueueFamilyProperties GetQueueFamilyProperties(uint32_t queueFamily)
+{
+    VkQueueFamilyProperties properties = VkQueueFamilyProperties();
+    if (queueFamily == kGraphicsQueueFamily) {
+        properties.queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+        properties.queueCount = kMaxQueueCount;
+    } else {
+        properties.queueFlags = VK_QUEUE_VIDEO_DECODE_BIT_KHR | VK_QUEUE_TRANSFER_BIT;
+        properties.queueCount = 1;
+    }
+    properties.timestampValidBits = 64;
+    properties.minImageTransferGranularity = { 1, 1, 1 };
+    return properties;
+}
+
+VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceQueueFamilyProperties(VkPhysicalDevice physicalDevice, uint32_t* pQueueFamilyPropertyCount,
+                                                                  VkQueueFamilyProperties* pQueueFamilyProperties)
+{
+    const VkQueueFamilyProperties properties[kQueueFamilyCount] = {
+        GetQueueFamilyProperties(kGraphicsQueueFamily), GetQueueFamilyProperties(kVideoDecodeQueueFamily)
+    };
+    EnumerateArray(properties, kQueueFamilyCount, pQueueFamilyPropertyCount, pQueueFamilyProperties);
+}
+
+VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceQueueFamilyProperties2(VkPhysicalDevice physicalDevice, uint32_t* pQueueFamilyPropertyCount,
+                                                                   VkQueueFamilyProperties2* pQueueFamilyProperties)
+{
+    if (pQueueFamilyProperties == NULL) {
+        *pQueueFamilyPropertyCount = kQueueFamilyCount;
+        return;
+    }
+    *pQueueFamilyPropertyCount = std::min(*pQueueFamilyPropertyCount, kQueueFamilyCount);
+    for (uint32_t queueFamily = 0; queueFamily < *pQueueFamilyPropertyCount; queueFamily++) {
+        pQueueFamilyProperties[queueFamily].queueFamilyProperties = GetQueueFamilyProperties(queueFamily);
+        for (VkBaseOutStructure* pNext = (VkBaseOutStructure*)pQueueFamilyProperties[queueFamily].pNext; pNext; pNext = pNext->pNext) {
+            if (pNext->sType == VK_STRUCTURE_TYPE_VIDEO_QUEUE_FAMILY_PROPERTIES_2_KHR) {
+                ((VkVideoQueueFamilyProperties2KHR*)pNext)->videoCodecOperations = (queueFamily == kVideoDecodeQueueFamily) ?
+                    (VK_VIDEO_CODEC_OPERATION_DECODE_H264_BIT_EXT | VK_VIDEO_CODEC_OPERATION_DECODE_H265_BIT_EXT) :
+                    VK_VIDEO_CODEC_OPERATION_INVALID_BIT_KHR;
+            }
+        }
+    }
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL EnumerateDeviceExtensionProperties(VkPhysicalDevice physicalDevice, const char* pLayerName,
+                                                                  uint32_t* pPropertyCount, VkExtensionProperties* pProperties)
+{
+    if (pLayerName != NULL) {
+        return VK_ERROR_LAYER_NOT_PRESENT;
+    }
+    return EnumerateArray(deviceExtensions, sizeof(deviceExtensions) / sizeof(deviceExtensions[0]), pPropertyCount, pProperties);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceVideoCapabilitiesKHR(VkPhysicalDevice physicalDevice, const VkVideoProfileKHR* pVideoProfile,
+                                                                     VkVideoCapabilitiesKHR* pCapabilities)
+{
+    if ((pVideoProfile->videoCodecOperation != VK_VIDEO_CODEC_OPERATION_DECODE_H264_BIT_EXT) &&
+        (pVideoProfile->videoCodecOperation != VK_VIDEO_CODEC_OPERATION_DECODE_H265_BIT_EXT)) {
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+    pCapabilities->capabilityFlags = 0;
+    pCapabilities->minBitstreamBufferOffsetAlignment = kAlignment;
+    pCapabilities->minBitstreamBufferSizeAlignment = kAlignment;
+    pCapabilities->videoPictureExtentGranularity = { 1, 1 };
+    pCapabilities->minExtent = { 16, 16 };
+    pCapabilities->maxExtent = { 8192, 8192 };
+    pCapabilities->maxReferencePicturesSlotsCount = 17;
+    pCapabilities->maxReferencePicturesActiveCount = 16;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceVideoFormatPropertiesKHR(VkPhysicalDevice physicalDevice,
+                                                                         const VkPhysicalDeviceVideoFormatInfoKHR* pVideoFormatInfo,
+                                                                         uint32_t* pVideoFormatPropertyCount,
+                                                                         VkVideoFormatPropertiesKHR* pVideoFormatProperties)
+{
+    static const VkFormat formats[] = {
+        VK_FORMAT_G8_B8R8_2PLANE_420_UNORM,
+        VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16,
+    };
+    const uint32_t formatCount = sizeof(formats) / sizeof(formats[0]);
+    if (pVideoFormatProperties == NULL) {
+        *pVideoFormatPropertyCount = formatCount;
+        return VK_SUCCESS;
+    }
+    const uint32_t count = std::min(*pVideoFormatPropertyCount, formatCount);
+    for (uint32_t i = 0; i < count; i++) {
+        pVideoFormatProperties[i].format = formats[i];
+    }
+    *pVideoFormatPropertyCount = count;
+    return (count < formatCount) ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Display and surface
+
+VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceDisplayPropertiesKHR(VkPhysicalDevice physicalDevice, uint32_t* pPropertyCount,
+                                                                     VkDisplayPropertiesKHR* pProperties)
+{
+    MockInstance* pInstance = reinterpret_cast<MockInstance*>((uint8_t*)physicalDevice - offsetof(MockInstance, physicalDevice));
+    VkDisplayPropertiesKHR properties = VkDisplayPropertiesKHR();
+    properties.display = pInstance->display;
+    properties.displayName = "Vulkan Video Mock Display";
+    properties.physicalDimensions = { 600, 340 };
+    properties.physicalResolution = kDisplayResolution;
+    properties.supportedTransforms = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+    return EnumerateArray(&properties, 1, pPropertyCount, pProperties);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceDisplayPlanePropertiesKHR(VkPhysicalDevice physicalDevice, uint32_t* pPropertyCount,
+                                                                          VkDisplayPlanePropertiesKHR* pProperties)
+{
+    MockInstance* pInstance = reinterpret_cast<MockInstance*>((uint8_t*)physicalDevice - offsetof(MockInstance, physicalDevice));
+    const VkDisplayPlanePropertiesKHR properties = { pInstance->display, 0 };
+    return EnumerateArray(&properties, 1, pPropertyCount, pProperties);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetDisplayPlaneSupportedDisplaysKHR(VkPhysicalDevice physicalDevice, uint32_t planeIndex,
+                                                                   uint32_t* pDisplayCount, VkDisplayKHR* pDisplays)
+{
+    MockInstance* pInstance = reinterpret_cast<MockInstance*>((uint8_t*)physicalDevice - offsetof(MockInstance, physicalDevice));
+    return EnumerateArray(&pInstance->display, (planeIndex == 0) ? 1 : 0, pDisplayCount, pDisplays);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetDisplayModePropertiesKHR(VkPhysicalDevice physicalDevice, VkDisplayKHR display, uint32_t* pPropertyCount,
+                                                           VkDisplayModePropertiesKHR* pProperties)
+{
+    MockInstance* pInstance = reinterpret_cast<MockInstance*>((uint8_t*)physicalDevice - offsetof(MockInstance, physicalDevice));
+    const VkDisplayModePropertiesKHR properties = { pInstance->displayMode, { kDisplayResolution, 60000 } };
+    return EnumerateArray(&properties, 1, pPropertyCount, pProperties);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetDisplayPlaneCapabilitiesKHR(VkPhysicalDevice physicalDevice, VkDisplayModeKHR mode, uint32_t planeIndex,
+                                                              VkDisplayPlaneCapabilitiesKHR* pCapabilities)
+{
+    memset(pCapabilities, 0, sizeof(*pCapabilities));
+    pCapabilities->supportedAlpha = VK_DISPLAY_PLANE_ALPHA_OPAQUE_BIT_KHR;
+    pCapabilities->maxSrcExtent = kDisplayResolution;
+    pCapabilities->maxDstExtent = kDisplayResolution;
+    pCapabilities->minSrcExtent = { 1, 1 };
+    pCapabilities->minDstExtent = { 1, 1 };
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ReleaseDisplayEXT(VkPhysicalDevice physicalDevice, VkDisplayKHR display)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateDisplayPlaneSurfaceKHR(VkInstance instance, const VkDisplaySurfaceCreateInfoKHR* pCreateInfo,
+                                                            const VkAllocationCallbacks* pAllocator, VkSurfaceKHR* pSurface)
+{
+    MockSurface* pMockSurface = new MockSurface();
+    pMockSurface->currentExtent = pCreateInfo->imageExtent;
+    *pSurface = ToHandle<VkSurfaceKHR>(pMockSurface);
+    return VK_SUCCESS;
+}
+
+#ifdef VK_USE_PLATFORM_XCB_KHR
+VKAPI_ATTR VkResult VKAPI_CALL CreateXcbSurfaceKHR(VkInstance instance, const VkXcbSurfaceCreateInfoKHR* pCreateInfo,
+                                                   const VkAllocationCallbacks* pAllocator, VkSurfaceKHR* pSurface)
+{
+    // The swapchain extent follows the window size hints of the application
+    MockSurface* pMockSurface = new MockSurface();
+    pMockSurface->currentExtent = { UINT32_MAX, UINT32_MAX };
+    *pSurface = ToHandle<VkSurfaceKHR>(pMockSurface);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkBool32 VKAPI_CALL GetPhysicalDeviceXcbPresentationSupportKHR(VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex,
+                                                                          xcb_connection_t* connection, xcb_visualid_t visual_id)
+{
+    return (queueFamilyIndex == kGraphicsQueueFamily) ? VK_TRUE : VK_FALSE;
+}
+#endif
+
+VKAPI_ATTR void VKAPI_CALL DestroySurfaceKHR(VkInstance instance, VkSurfaceKHR surface, const VkAllocationCallbacks* pAllocator)
+{
+    delete FromHandle<MockSurface>(surface);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceSupportKHR(VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex,
+                                                                  VkSurfaceKHR surface, VkBool32* pSupported)
+{
+    *pSupported = (queueFamilyIndex == kGraphicsQueueFamily) ? VK_TRUE : VK_FALSE;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceCapabilitiesKHR(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface,
+                                                                       VkSurfaceCapabilitiesKHR* pSurfaceCapabilities)
+{
+    pSurfaceCapabilities->minImageCount = 2;
+    pSurfaceCapabilities->maxImageCount = 8;
+    pSurfaceCapabilities->currentExtent = FromHandle<MockSurface>(surface)->currentExtent;
+    pSurfaceCapabilities->minImageExtent = { 1, 1 };
+    pSurfaceCapabilities->maxImageExtent = { 16384, 16384 };
+    pSurfaceCapabilities->maxImageArrayLayers = 1;
+    pSurfaceCapabilities->supportedTransforms = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+    pSurfaceCapabilities->currentTransform = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+    pSurfaceCapabilities->supportedCompositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    pSurfaceCapabilities->supportedUsageFlags = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                                                VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceFormatsKHR(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface,
+                                                                  uint32_t* pSurfaceFormatCount, VkSurfaceFormatKHR* pSurfaceFormats)
+{
+    const VkSurfaceFormatKHR format = { VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR };
+    return EnumerateArray(&format, 1, pSurfaceFormatCount, pSurfaceFormats);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfacePresentModesKHR(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface,
+                                                                       uint32_t* pPresentModeCount, VkPresentModeKHR* pPresentModes)
+{
+    static const VkPresentModeKHR modes[] = { VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR };
+    return EnumerateArray(modes, sizeof(modes) / sizeof(modes[0]), pPresentModeCount, pPresentModes);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Device and queues
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo* pCreateInfo,
+                                            const VkAllocationCallbacks* pAllocator, VkDevice* pDevice)
+{
+    MockDevice* pMockDevice = new MockDevice();
+    pMockDevice->loaderMagic = ICD_LOADER_MAGIC;
+    for (uint32_t queueFamily = 0; queueFamily < kQueueFamilyCount; queueFamily++) {
+        for (uint32_t queueIndex = 0; queueIndex < kMaxQueueCount; queueIndex++) {
+            pMockDevice->queues[queueFamily][queueIndex].loaderMagic = ICD_LOADER_MAGIC;
+        }
+    }
+    *pDevice = reinterpret_cast<VkDevice>(pMockDevice);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCallbacks* pAllocator)
+{
+    delete reinterpret_cast<MockDevice*>(device);
+}
+
+VKAPI_ATTR void VKAPI_CALL GetDeviceQueue(VkDevice device, uint32_t queueFamilyIndex, uint32_t queueIndex, VkQueue* pQueue)
+{
+    MockDevice* pMockDevice = reinterpret_cast<MockDevice*>(device);
+    *pQueue = reinterpret_cast<VkQueue>(&pMockDevice->queues[queueFamilyIndex % kQueueFamilyCount][queueIndex % kMaxQueueCount]);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL DeviceWaitIdle(VkDevice device)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL QueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence fence)
+{
+    SignalFence(fence);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL QueueSubmit2KHR(VkQueue queue, uint32_t submitCount, const VkSubmitInfo2KHR* pSubmits, VkFence fence)
+{
+    SignalFence(fence);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL QueueWaitIdle(VkQueue queue)
+{
+    return VK_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Synchronization
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateFence(VkDevice device, const VkFenceCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator,
+                                           VkFence* pFence)
+{
+    MockFence* pMockFence = new MockFence();
+    pMockFence->signaled = (pCreateInfo->flags & VK_FENCE_CREATE_SIGNALED_BIT) != 0;
+    *pFence = ToHandle<VkFence>(pMockFence);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyFence(VkDevice device, VkFence fence, const VkAllocationCallbacks* pAllocator)
+{
+    delete FromHandle<MockFence>(fence);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ResetFences(VkDevice device, uint32_t fenceCount, const VkFence* pFences)
+{
+    for (uint32_t i = 0; i < fenceCount; i++) {
+        FromHandle<MockFence>(pFences[i])->signaled = false;
+    }
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetFenceStatus(VkDevice device, VkFence fence)
+{
+    return FromHandle<MockFence>(fence)->signaled ? VK_SUCCESS : VK_NOT_READY;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL WaitForFences(VkDevice device, uint32_t fenceCount, const VkFence* pFences, VkBool32 waitAll, uint64_t timeout)
+{
+    // The work is done at submission, a fence that is not signaled yet never will be
+    uint32_t signaledCount = 0;
+    for (uint32_t i = 0; i < fenceCount; i++) {
+        if (FromHandle<MockFence>(pFences[i])->signaled) {
+            signaledCount++;
+        }
+    }
+    const bool done = waitAll ? (signaledCount == fenceCount) : (signaledCount != 0);
+    return done ? VK_SUCCESS : VK_TIMEOUT;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetFenceFdKHR(VkDevice device, const VkFenceGetFdInfoKHR* pGetFdInfo, int* pFd)
+{
+    // A sync fd of -1 is an already signaled fence
+    *pFd = -1;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateSemaphore(VkDevice device, const VkSemaphoreCreateInfo* pCreateInfo,
+                                               const VkAllocationCallbacks* pAllocator, VkSemaphore* pSemaphore)
+{
+    *pSemaphore = NewHandle<VkSemaphore>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroySemaphore(VkDevice device, VkSemaphore semaphore, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateQueryPool(VkDevice device, const VkQueryPoolCreateInfo* pCreateInfo,
+                                               const VkAllocationCallbacks* pAllocator, VkQueryPool* pQueryPool)
+{
+    *pQueryPool = NewHandle<VkQueryPool>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyQueryPool(VkDevice device, VkQueryPool queryPool, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetQueryPoolResults(VkDevice device, VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount,
+                                                   size_t dataSize, void* pData, VkDeviceSize stride, VkQueryResultFlags flags)
+{
+    // Every query reports VK_QUERY_RESULT_STATUS_COMPLETE_KHR, and is available
+    const size_t valueSize = (flags & VK_QUERY_RESULT_64_BIT) ? sizeof(uint64_t) : sizeof(uint32_t);
+    const uint32_t valueCount = (flags & VK_QUERY_RESULT_WITH_AVAILABILITY_BIT) ? 2 : 1;
+    for (uint32_t query = 0; query < queryCount; query++) {
+        uint8_t* pResult = (uint8_t*)pData + query * stride;
+        for (uint32_t value = 0; value < valueCount; value++, pResult += valueSize) {
+            if ((size_t)(pResult + valueSize - (uint8_t*)pData) > dataSize) {
+                return VK_SUCCESS;
+            }
+            if (valueSize == sizeof(uint64_t)) {
+                *(uint64_t*)pResult = VK_QUERY_RESULT_STATUS_COMPLETE_KHR;
+            } else {
+                *(uint32_t*)pResult = VK_QUERY_RESULT_STATUS_COMPLETE_KHR;
+            }
+        }
+    }
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL ResetQueryPool(VkDevice device, VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Memory, buffers and images
+
+VKAPI_ATTR VkResult VKAPI_CALL AllocateMemory(VkDevice device, const VkMemoryAllocateInfo* pAllocateInfo,
+                                              const VkAllocationCallbacks* pAllocator, VkDeviceMemory* pMemory)
+{
+    // The host storage is only allocated when the memory is mapped, the decoded pictures never are
+    MockDeviceMemory* pMockMemory = new MockDeviceMemory();
+    pMockMemory->size = pAllocateInfo->allocationSize;
+    pMockMemory->data = NULL;
+    *pMemory = ToHandle<VkDeviceMemory>(pMockMemory);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL FreeMemory(VkDevice device, VkDeviceMemory memory, const VkAllocationCallbacks* pAllocator)
+{
+    MockDeviceMemory* pMockMemory = FromHandle<MockDeviceMemory>(memory);
+    if (pMockMemory) {
+        free(pMockMemory->data);
+        delete pMockMemory;
+    }
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL MapMemory(VkDevice device, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize size,
+                                         VkMemoryMapFlags flags, void** ppData)
+{
+    MockDeviceMemory* pMockMemory = FromHandle<MockDeviceMemory>(memory);
+    if (pMockMemory->data == NULL) {
+        pMockMemory->data = calloc(1, (size_t)pMockMemory->size);
+        if (pMockMemory->data == NULL) {
+            return VK_ERROR_MEMORY_MAP_FAILED;
+        }
+    }
+    *ppData = (uint8_t*)pMockMemory->data + offset;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL UnmapMemory(VkDevice device, VkDeviceMemory memory)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL FlushMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount, const VkMappedMemoryRange* pMemoryRanges)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL InvalidateMappedMemoryRanges(VkDevice device, uint32_t memoryRangeCount,
+                                                            const VkMappedMemoryRange* pMemoryRanges)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetMemoryFdKHR(VkDevice device, const VkMemoryGetFdInfoKHR* pGetFdInfo, int* pFd)
+{
+    *pFd = -1;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateBuffer(VkDevice device, const VkBufferCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator,
+                                            VkBuffer* pBuffer)
+{
+    MockBuffer* pMockBuffer = new MockBuffer();
+    pMockBuffer->size = pCreateInfo->size;
+    *pBuffer = ToHandle<VkBuffer>(pMockBuffer);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyBuffer(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks* pAllocator)
+{
+    delete FromHandle<MockBuffer>(buffer);
+}
+
+VKAPI_ATTR void VKAPI_CALL GetBufferMemoryRequirements(VkDevice device, VkBuffer buffer, VkMemoryRequirements* pMemoryRequirements)
+{
+    pMemoryRequirements->size = AlignUp(FromHandle<MockBuffer>(buffer)->size, kAlignment);
+    pMemoryRequirements->alignment = kAlignment;
+    pMemoryRequirements->memoryTypeBits = 1;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL BindBufferMemory(VkDevice device, VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateImage(VkDevice device, const VkImageCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator,
+                                           VkImage* pImage)
+{
+    *pImage = ToHandle<VkImage>(NewImage(pCreateInfo->format, pCreateInfo->extent));
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks* pAllocator)
+{
+    delete FromHandle<MockImage>(image);
+}
+
+VKAPI_ATTR void VKAPI_CALL GetImageMemoryRequirements(VkDevice device, VkImage image, VkMemoryRequirements* pMemoryRequirements)
+{
+    const MockImage* pMockImage = FromHandle<MockImage>(image);
+    pMemoryRequirements->size = pMockImage->planes * pMockImage->planeSize;
+    pMemoryRequirements->alignment = kAlignment;
+    pMemoryRequirements->memoryTypeBits = 1;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL BindImageMemory(VkDevice device, VkImage image, VkDeviceMemory memory, VkDeviceSize memoryOffset)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL GetImageSubresourceLayout(VkDevice device, VkImage image, const VkImageSubresource* pSubresource,
+                                                     VkSubresourceLayout* pLayout)
+{
+    const MockImage* pMockImage = FromHandle<MockImage>(image);
+    uint32_t plane = 0;
+    if (pSubresource->aspectMask & VK_IMAGE_ASPECT_PLANE_1_BIT) {
+        plane = 1;
+    } else if (pSubresource->aspectMask & VK_IMAGE_ASPECT_PLANE_2_BIT) {
+        plane = 2;
+    }
+    pLayout->offset = std::min(plane, pMockImage->planes - 1) * pMockImage->planeSize;
+    pLayout->size = pMockImage->planeSize;
+    pLayout->rowPitch = pMockImage->rowPitch;
+    pLayout->arrayPitch = pMockImage->planes * pMockImage->planeSize;
+    pLayout->depthPitch = pLayout->arrayPitch;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateImageView(VkDevice device, const VkImageViewCreateInfo* pCreateInfo,
+                                               const VkAllocationCallbacks* pAllocator, VkImageView* pView)
+{
+    *pView = NewHandle<VkImageView>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyImageView(VkDevice device, VkImageView imageView, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateSampler(VkDevice device, const VkSamplerCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator,
+                                             VkSampler* pSampler)
+{
+    *pSampler = NewHandle<VkSampler>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroySampler(VkDevice device, VkSampler sampler, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateSamplerYcbcrConversion(VkDevice device, const VkSamplerYcbcrConversionCreateInfo* pCreateInfo,
+                                                            const VkAllocationCallbacks* pAllocator,
+                                                            VkSamplerYcbcrConversion* pYcbcrConversion)
+{
+    *pYcbcrConversion = NewHandle<VkSamplerYcbcrConversion>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroySamplerYcbcrConversion(VkDevice device, VkSamplerYcbcrConversion ycbcrConversion,
+                                                         const VkAllocationCallbacks* pAllocator)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Pipelines and descriptors
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo* pCreateInfo,
+                                                  const VkAllocationCallbacks* pAllocator, VkShaderModule* pShaderModule)
+{
+    *pShaderModule = NewHandle<VkShaderModule>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyShaderModule(VkDevice device, VkShaderModule shaderModule, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineCache(VkDevice device, const VkPipelineCacheCreateInfo* pCreateInfo,
+                                                   const VkAllocationCallbacks* pAllocator, VkPipelineCache* pPipelineCache)
+{
+    *pPipelineCache = NewHandle<VkPipelineCache>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyPipelineCache(VkDevice device, VkPipelineCache pipelineCache, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineLayout(VkDevice device, const VkPipelineLayoutCreateInfo* pCreateInfo,
+                                                    const VkAllocationCallbacks* pAllocator, VkPipelineLayout* pPipelineLayout)
+{
+    *pPipelineLayout = NewHandle<VkPipelineLayout>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyPipelineLayout(VkDevice device, VkPipelineLayout pipelineLayout, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateGraphicsPipelines(VkDevice device, VkPipelineCache pipelineCache, uint32_t createInfoCount,
+                                                       const VkGraphicsPipelineCreateInfo* pCreateInfos,
+                                                       const VkAllocationCallbacks* pAllocator, VkPipeline* pPipelines)
+{
+    for (uint32_t i = 0; i < createInfoCount; i++) {
+        pPipelines[i] = NewHandle<VkPipeline>();
+    }
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(VkDevice device, const VkRenderPassCreateInfo* pCreateInfo,
+                                                const VkAllocationCallbacks* pAllocator, VkRenderPass* pRenderPass)
+{
+    *pRenderPass = NewHandle<VkRenderPass>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyRenderPass(VkDevice device, VkRenderPass renderPass, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateFramebuffer(VkDevice device, const VkFramebufferCreateInfo* pCreateInfo,
+                                                 const VkAllocationCallbacks* pAllocator, VkFramebuffer* pFramebuffer)
+{
+    *pFramebuffer = NewHandle<VkFramebuffer>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateDescriptorSetLayout(VkDevice device, const VkDescriptorSetLayoutCreateInfo* pCreateInfo,
+                                                         const VkAllocationCallbacks* pAllocator, VkDescriptorSetLayout* pSetLayout)
+{
+    *pSetLayout = NewHandle<VkDescriptorSetLayout>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyDescriptorSetLayout(VkDevice device, VkDescriptorSetLayout descriptorSetLayout,
+                                                      const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateDescriptorPool(VkDevice device, const VkDescriptorPoolCreateInfo* pCreateInfo,
+                                                    const VkAllocationCallbacks* pAllocator, VkDescriptorPool* pDescriptorPool)
+{
+    *pDescriptorPool = NewHandle<VkDescriptorPool>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL AllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo* pAllocateInfo,
+                                                      VkDescriptorSet* pDescriptorSets)
+{
+    for (uint32_t i = 0; i < pAllocateInfo->descriptorSetCount; i++) {
+        pDescriptorSets[i] = NewHandle<VkDescriptorSet>();
+    }
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL FreeDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool, uint32_t descriptorSetCount,
+                                                  const VkDescriptorSet* pDescriptorSets)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL UpdateDescriptorSets(VkDevice device, uint32_t descriptorWriteCount, const VkWriteDescriptorSet* pDescriptorWrites,
+                                                uint32_t descriptorCopyCount, const VkCopyDescriptorSet* pDescriptorCopies)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Command buffers
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPool(VkDevice device, const VkCommandPoolCreateInfo* pCreateInfo,
+                                                 const VkAllocationCallbacks* pAllocator, VkCommandPool* pCommandPool)
+{
+    *pCommandPool = ToHandle<VkCommandPool>(new MockCommandPool());
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyCommandPool(VkDevice device, VkCommandPool commandPool, const VkAllocationCallbacks* pAllocator)
+{
+    MockCommandPool* pMockPool = FromHandle<MockCommandPool>(commandPool);
+    if (pMockPool) {
+        for (size_t i = 0; i < pMockPool->commandBuffers.size(); i++) {
+            delete pMockPool->commandBuffers[i];
+        }
+        delete pMockPool;
+    }
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ResetCommandPool(VkDevice device, VkCommandPool commandPool, VkCommandPoolResetFlags flags)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL AllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo* pAllocateInfo,
+                                                      VkCommandBuffer* pCommandBuffers)
+{
+    MockCommandPool* pMockPool = FromHandle<MockCommandPool>(pAllocateInfo->commandPool);
+    for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; i++) {
+        MockCommandBuffer* pMockCommandBuffer = new MockCommandBuffer();
+        pMockCommandBuffer->loaderMagic = ICD_LOADER_MAGIC;
+        pMockPool->commandBuffers.push_back(pMockCommandBuffer);
+        pCommandBuffers[i] = reinterpret_cast<VkCommandBuffer>(pMockCommandBuffer);
+    }
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL FreeCommandBuffers(VkDevice device, VkCommandPool commandPool, uint32_t commandBufferCount,
+                                              const VkCommandBuffer* pCommandBuffers)
+{
+    std::vector<MockCommandBuffer*>& poolCommandBuffers = FromHandle<MockCommandPool>(commandPool)->commandBuffers;
+    for (uint32_t i = 0; i < commandBufferCount; i++) {
+        MockCommandBuffer* pMockCommandBuffer = reinterpret_cast<MockCommandBuffer*>(pCommandBuffers[i]);
+        std::vector<MockCommandBuffer*>::iterator it = std::find(poolCommandBuffers.begin(), poolCommandBuffers.end(), pMockCommandBuffer);
+        if (it != poolCommandBuffers.end()) {
+            poolCommandBuffers.erase(it);
+            delete pMockCommandBuffer;
+        }
+    }
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL BeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo* pBeginInfo)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL EndCommandBuffer(VkCommandBuffer commandBuffer)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ResetCommandBuffer(VkCommandBuffer commandBuffer, VkCommandBufferResetFlags flags)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask,
+                                              VkDependencyFlags dependencyFlags, uint32_t memoryBarrierCount,
+                                              const VkMemoryBarrier* pMemoryBarriers, uint32_t bufferMemoryBarrierCount,
+                                              const VkBufferMemoryBarrier* pBufferMemoryBarriers, uint32_t imageMemoryBarrierCount,
+                                              const VkImageMemoryBarrier* pImageMemoryBarriers)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdPipelineBarrier2KHR(VkCommandBuffer commandBuffer, const VkDependencyInfoKHR* pDependencyInfo)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdBeginRenderPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo* pRenderPassBegin,
+                                              VkSubpassContents contents)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdEndRenderPass(VkCommandBuffer commandBuffer)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdBindPipeline(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipeline pipeline)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdBindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout,
+                                                 uint32_t firstSet, uint32_t descriptorSetCount, const VkDescriptorSet* pDescriptorSets,
+                                                 uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdBindVertexBuffers(VkCommandBuffer commandBuffer, uint32_t firstBinding, uint32_t bindingCount,
+                                                const VkBuffer* pBuffers, const VkDeviceSize* pOffsets)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdSetViewport(VkCommandBuffer commandBuffer, uint32_t firstViewport, uint32_t viewportCount,
+                                          const VkViewport* pViewports)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdSetScissor(VkCommandBuffer commandBuffer, uint32_t firstScissor, uint32_t scissorCount, const VkRect2D* pScissors)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdPushConstants(VkCommandBuffer commandBuffer, VkPipelineLayout layout, VkShaderStageFlags stageFlags,
+                                            uint32_t offset, uint32_t size, const void* pValues)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex,
+                                   uint32_t firstInstance)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdCopyImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage,
+                                        VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageCopy* pRegions)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkImage dstImage,
+                                                VkImageLayout dstImageLayout, uint32_t regionCount, const VkBufferImageCopy* pRegions)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdBeginQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t query, VkQueryControlFlags flags)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdEndQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t query)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdResetQueryPool(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Video sessions
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateVideoSessionKHR(VkDevice device, const VkVideoSessionCreateInfoKHR* pCreateInfo,
+                                                     const VkAllocationCallbacks* pAllocator, VkVideoSessionKHR* pVideoSession)
+{
+    *pVideoSession = NewHandle<VkVideoSessionKHR>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyVideoSessionKHR(VkDevice device, VkVideoSessionKHR videoSession, const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetVideoSessionMemoryRequirementsKHR(VkDevice device, VkVideoSessionKHR videoSession,
+                                                                    uint32_t* pVideoSessionMemoryRequirementsCount,
+                                                                    VkVideoGetMemoryPropertiesKHR* pVideoSessionMemoryRequirements)
+{
+    // One binding for the session context
+    if (pVideoSessionMemoryRequirements == NULL) {
+        *pVideoSessionMemoryRequirementsCount = 1;
+        return VK_SUCCESS;
+    }
+    if (*pVideoSessionMemoryRequirementsCount < 1) {
+        return VK_INCOMPLETE;
+    }
+    *pVideoSessionMemoryRequirementsCount = 1;
+    pVideoSessionMemoryRequirements[0].memoryBindIndex = 0;
+    VkMemoryRequirements& memoryRequirements = pVideoSessionMemoryRequirements[0].pMemoryRequirements->memoryRequirements;
+    memoryRequirements.size = 64 * 1024;
+    memoryRequirements.alignment = kAlignment;
+    memoryRequirements.memoryTypeBits = 1;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL BindVideoSessionMemoryKHR(VkDevice device, VkVideoSessionKHR videoSession, uint32_t videoSessionBindMemoryCount,
+                                                         const VkVideoBindMemoryKHR* pVideoSessionBindMemories)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateVideoSessionParametersKHR(VkDevice device, const VkVideoSessionParametersCreateInfoKHR* pCreateInfo,
+                                                               const VkAllocationCallbacks* pAllocator,
+                                                               VkVideoSessionParametersKHR* pVideoSessionParameters)
+{
+    *pVideoSessionParameters = NewHandle<VkVideoSessionParametersKHR>();
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL UpdateVideoSessionParametersKHR(VkDevice device, VkVideoSessionParametersKHR videoSessionParameters,
+                                                               const VkVideoSessionParametersUpdateInfoKHR* pUpdateInfo)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroyVideoSessionParametersKHR(VkDevice device, VkVideoSessionParametersKHR videoSessionParameters,
+                                                            const VkAllocationCallbacks* pAllocator)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdBeginVideoCodingKHR(VkCommandBuffer commandBuffer, const VkVideoBeginCodingInfoKHR* pBeginInfo)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdEndVideoCodingKHR(VkCommandBuffer commandBuffer, const VkVideoEndCodingInfoKHR* pEndCodingInfo)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdControlVideoCodingKHR(VkCommandBuffer commandBuffer, const VkVideoCodingControlInfoKHR* pCodingControlInfo)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL CmdDecodeVideoKHR(VkCommandBuffer commandBuffer, const VkVideoDecodeInfoKHR* pFrameInfo)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Swapchain and display control
+
+VKAPI_ATTR VkResult VKAPI_CALL CreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInfoKHR* pCreateInfo,
+                                                  const VkAllocationCallbacks* pAllocator, VkSwapchainKHR* pSwapchain)
+{
+    MockSwapchain* pMockSwapchain = new MockSwapchain();
+    const VkExtent3D extent = { pCreateInfo->imageExtent.width, pCreateInfo->imageExtent.height, 1 };
+    for (uint32_t i = 0; i < pCreateInfo->minImageCount; i++) {
+        pMockSwapchain->images.push_back(NewImage(pCreateInfo->imageFormat, extent));
+    }
+    pMockSwapchain->nextImage = 0;
+    *pSwapchain = ToHandle<VkSwapchainKHR>(pMockSwapchain);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL DestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks* pAllocator)
+{
+    MockSwapchain* pMockSwapchain = FromHandle<MockSwapchain>(swapchain);
+    if (pMockSwapchain) {
+        for (size_t i = 0; i < pMockSwapchain->images.size(); i++) {
+            delete pMockSwapchain->images[i];
+        }
+        delete pMockSwapchain;
+    }
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t* pSwapchainImageCount,
+                                                     VkImage* pSwapchainImages)
+{
+    const MockSwapchain* pMockSwapchain = FromHandle<MockSwapchain>(swapchain);
+    std::vector<VkImage> images;
+    for (size_t i = 0; i < pMockSwapchain->images.size(); i++) {
+        images.push_back(ToHandle<VkImage>(pMockSwapchain->images[i]));
+    }
+    return EnumerateArray(images.data(), (uint32_t)images.size(), pSwapchainImageCount, pSwapchainImages);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout, VkSemaphore semaphore,
+                                                   VkFence fence, uint32_t* pImageIndex)
+{
+    MockSwapchain* pMockSwapchain = FromHandle<MockSwapchain>(swapchain);
+    *pImageIndex = pMockSwapchain->nextImage;
+    pMockSwapchain->nextImage = (pMockSwapchain->nextImage + 1) % (uint32_t)pMockSwapchain->images.size();
+    SignalFence(fence);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInfoKHR* pPresentInfo)
+{
+    if (pPresentInfo->pResults) {
+        for (uint32_t i = 0; i < pPresentInfo->swapchainCount; i++) {
+            pPresentInfo->pResults[i] = VK_SUCCESS;
+        }
+    }
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL DisplayPowerControlEXT(VkDevice device, VkDisplayKHR display, const VkDisplayPowerInfoEXT* pDisplayPowerInfo)
+{
+    return VK_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Entry points
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance, const char* pName);
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice device, const char* pName);
+
+struct EntryPoint {
+    const char* pName;
+    PFN_vkVoidFunction pFunction;
+    bool physicalDeviceCommand;
+};
+
+// The static_cast checks the signatures of the mock functions against the Vulkan headers
+#define MOCK_ENTRY_POINT(name) { "vk" #name, reinterpret_cast<PFN_vkVoidFunction>(static_cast<PFN_vk##name>(name)), false }
+#define MOCK_PHYSICAL_DEVICE_ENTRY_POINT(name) { "vk" #name, reinterpret_cast<PFN_vkVoidFunction>(static_cast<PFN_vk##name>(name)), true }
+#define MOCK_ENTRY_POINT_ALIAS(alias, name) { "vk" #alias, reinterpret_cast<PFN_vkVoidFunction>(static_cast<PFN_vk##alias>(name)), false }
+#define MOCK_PHYSICAL_DEVICE_ENTRY_POINT_ALIAS(alias, name) { "vk" #alias, reinterpret_cast<PFN_vkVoidFunction>(static_cast<PFN_vk##alias>(name)), true }
+
+const EntryPoint entryPoints[] = {
+    MOCK_ENTRY_POINT(GetInstanceProcAddr),
+    MOCK_ENTRY_POINT(GetDeviceProcAddr),
+    MOCK_ENTRY_POINT(CreateInstance),
+    MOCK_ENTRY_POINT(DestroyInstance),
+    MOCK_ENTRY_POINT(EnumerateInstanceExtensionProperties),
+    MOCK_ENTRY_POINT(EnumerateInstanceVersion),
+    MOCK_ENTRY_POINT(EnumeratePhysicalDevices),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceProperties),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceProperties2),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT_ALIAS(GetPhysicalDeviceProperties2KHR, GetPhysicalDeviceProperties2),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceFeatures),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceFeatures2),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT_ALIAS(GetPhysicalDeviceFeatures2KHR, GetPhysicalDeviceFeatures2),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceFormatProperties),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceFormatProperties2),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT_ALIAS(GetPhysicalDeviceFormatProperties2KHR, GetPhysicalDeviceFormatProperties2),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceImageFormatProperties),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceSparseImageFormatProperties),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceMemoryProperties),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceMemoryProperties2),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT_ALIAS(GetPhysicalDeviceMemoryProperties2KHR, GetPhysicalDeviceMemoryProperties2),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceQueueFamilyProperties),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceQueueFamilyProperties2),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT_ALIAS(GetPhysicalDeviceQueueFamilyProperties2KHR, GetPhysicalDeviceQueueFamilyProperties2),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(EnumerateDeviceExtensionProperties),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceVideoCapabilitiesKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceVideoFormatPropertiesKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceDisplayPropertiesKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceDisplayPlanePropertiesKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetDisplayPlaneSupportedDisplaysKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetDisplayModePropertiesKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetDisplayPlaneCapabilitiesKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(ReleaseDisplayEXT),
+    MOCK_ENTRY_POINT(CreateDisplayPlaneSurfaceKHR),
+#ifdef VK_USE_PLATFORM_XCB_KHR
+    MOCK_ENTRY_POINT(CreateXcbSurfaceKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceXcbPresentationSupportKHR),
+#endif
+    MOCK_ENTRY_POINT(DestroySurfaceKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceSurfaceSupportKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceSurfaceCapabilitiesKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceSurfaceFormatsKHR),
+    MOCK_PHYSICAL_DEVICE_ENTRY_POINT(GetPhysicalDeviceSurfacePresentModesKHR),
+    MOCK_ENTRY_POINT(CreateDevice),
+    MOCK_ENTRY_POINT(DestroyDevice),
+    MOCK_ENTRY_POINT(GetDeviceQueue),
+    MOCK_ENTRY_POINT(DeviceWaitIdle),
+    MOCK_ENTRY_POINT(QueueSubmit),
+    MOCK_ENTRY_POINT(QueueSubmit2KHR),
+    MOCK_ENTRY_POINT(QueueWaitIdle),
+    MOCK_ENTRY_POINT(CreateFence),
+    MOCK_ENTRY_POINT(DestroyFence),
+    MOCK_ENTRY_POINT(ResetFences),
+    MOCK_ENTRY_POINT(GetFenceStatus),
+    MOCK_ENTRY_POINT(WaitForFences),
+    MOCK_ENTRY_POINT(GetFenceFdKHR),
+    MOCK_ENTRY_POINT(CreateSemaphore),
+    MOCK_ENTRY_POINT(DestroySemaphore),
+    MOCK_ENTRY_POINT(CreateQueryPool),
+    MOCK_ENTRY_POINT(DestroyQueryPool),
+    MOCK_ENTRY_POINT(GetQueryPoolResults),
+    MOCK_ENTRY_POINT(ResetQueryPool),
+    MOCK_ENTRY_POINT_ALIAS(ResetQueryPoolEXT, ResetQueryPool),
+    MOCK_ENTRY_POINT(AllocateMemory),
+    MOCK_ENTRY_POINT(FreeMemory),
+    MOCK_ENTRY_POINT(MapMemory),
+    MOCK_ENTRY_POINT(UnmapMemory),
+    MOCK_ENTRY_POINT(FlushMappedMemoryRanges),
+    MOCK_ENTRY_POINT(InvalidateMappedMemoryRanges),
+    MOCK_ENTRY_POINT(GetMemoryFdKHR),
+    MOCK_ENTRY_POINT(CreateBuffer),
+    MOCK_ENTRY_POINT(DestroyBuffer),
+    MOCK_ENTRY_POINT(GetBufferMemoryRequirements),
+    MOCK_ENTRY_POINT(BindBufferMemory),
+    MOCK_ENTRY_POINT(CreateImage),
+    MOCK_ENTRY_POINT(DestroyImage),
+    MOCK_ENTRY_POINT(GetImageMemoryRequirements),
+    MOCK_ENTRY_POINT(BindImageMemory),
+    MOCK_ENTRY_POINT(GetImageSubresourceLayout),
+    MOCK_ENTRY_POINT(CreateImageView),
+    MOCK_ENTRY_POINT(DestroyImageView),
+    MOCK_ENTRY_POINT(CreateSampler),
+    MOCK_ENTRY_POINT(DestroySampler),
+    MOCK_ENTRY_POINT(CreateSamplerYcbcrConversion),
+    MOCK_ENTRY_POINT_ALIAS(CreateSamplerYcbcrConversionKHR, CreateSamplerYcbcrConversion),
+    MOCK_ENTRY_POINT(DestroySamplerYcbcrConversion),
+    MOCK_ENTRY_POINT_ALIAS(DestroySamplerYcbcrConversionKHR, DestroySamplerYcbcrConversion),
+    MOCK_ENTRY_POINT(CreateShaderModule),
+    MOCK_ENTRY_POINT(DestroyShaderModule),
+    MOCK_ENTRY_POINT(CreatePipelineCache),
+    MOCK_ENTRY_POINT(DestroyPipelineCache),
+    MOCK_ENTRY_POINT(CreatePipelineLayout),
+    MOCK_ENTRY_POINT(DestroyPipelineLayout),
+    MOCK_ENTRY_POINT(CreateGraphicsPipelines),
+    MOCK_ENTRY_POINT(DestroyPipeline),
+    MOCK_ENTRY_POINT(CreateRenderPass),
+    MOCK_ENTRY_POINT(DestroyRenderPass),
+    MOCK_ENTRY_POINT(CreateFramebuffer),
+    MOCK_ENTRY_POINT(DestroyFramebuffer),
+    MOCK_ENTRY_POINT(CreateDescriptorSetLayout),
+    MOCK_ENTRY_POINT(DestroyDescriptorSetLayout),
+    MOCK_ENTRY_POINT(CreateDescriptorPool),
+    MOCK_ENTRY_POINT(DestroyDescriptorPool),
+    MOCK_ENTRY_POINT(AllocateDescriptorSets),
+    MOCK_ENTRY_POINT(FreeDescriptorSets),
+    MOCK_ENTRY_POINT(UpdateDescriptorSets),
+    MOCK_ENTRY_POINT(CreateCommandPool),
+    MOCK_ENTRY_POINT(DestroyCommandPool),
+    MOCK_ENTRY_POINT(ResetCommandPool),
+    MOCK_ENTRY_POINT(AllocateCommandBuffers),
+    MOCK_ENTRY_POINT(FreeCommandBuffers),
+    MOCK_ENTRY_POINT(BeginCommandBuffer),
+    MOCK_ENTRY_POINT(EndCommandBuffer),
+    MOCK_ENTRY_POINT(ResetCommandBuffer),
+    MOCK_ENTRY_POINT(CmdPipelineBarrier),
+    MOCK_ENTRY_POINT(CmdPipelineBarrier2KHR),
+    MOCK_ENTRY_POINT(CmdBeginRenderPass),
+    MOCK_ENTRY_POINT(CmdEndRenderPass),
+    MOCK_ENTRY_POINT(CmdBindPipeline),
+    MOCK_ENTRY_POINT(CmdBindDescriptorSets),
+    MOCK_ENTRY_POINT(CmdBindVertexBuffers),
+    MOCK_ENTRY_POINT(CmdSetViewport),
+    MOCK_ENTRY_POINT(CmdSetScissor),
+    MOCK_ENTRY_POINT(CmdPushConstants),
+    MOCK_ENTRY_POINT(CmdDraw),
+    MOCK_ENTRY_POINT(CmdCopyImage),
+    MOCK_ENTRY_POINT(CmdCopyBufferToImage),
+    MOCK_ENTRY_POINT(CmdBeginQuery),
+    MOCK_ENTRY_POINT(CmdEndQuery),
+    MOCK_ENTRY_POINT(CmdResetQueryPool),
+    MOCK_ENTRY_POINT(CreateVideoSessionKHR),
+    MOCK_ENTRY_POINT(DestroyVideoSessionKHR),
+    MOCK_ENTRY_POINT(GetVideoSessionMemoryRequirementsKHR),
+    MOCK_ENTRY_POINT(BindVideoSessionMemoryKHR),
+    MOCK_ENTRY_POINT(CreateVideoSessionParametersKHR),
+    MOCK_ENTRY_POINT(UpdateVideoSessionParametersKHR),
+    MOCK_ENTRY_POINT(DestroyVideoSessionParametersKHR),
+    MOCK_ENTRY_POINT(CmdBeginVideoCodingKHR),
+    MOCK_ENTRY_POINT(CmdEndVideoCodingKHR),
+    MOCK_ENTRY_POINT(CmdControlVideoCodingKHR),
+    MOCK_ENTRY_POINT(CmdDecodeVideoKHR),
+    MOCK_ENTRY_POINT(CreateSwapchainKHR),
+    MOCK_ENTRY_POINT(DestroySwapchainKHR),
+    MOCK_ENTRY_POINT(GetSwapchainImagesKHR),
+    MOCK_ENTRY_POINT(AcquireNextImageKHR),
+    MOCK_ENTRY_POINT(QueuePresentKHR),
+    MOCK_ENTRY_POINT(DisplayPowerControlEXT),
+};
+
+const EntryPoint* FindEntryPoint(const char* pName)
+{
+    for (size_t i = 0; i < sizeof(entryPoints) / sizeof(entryPoints[0]); i++) {
+        if (strcmp(entryPoints[i].pName, pName) == 0) {
+            return &entryPoints[i];
+        }
+    }
+    return NULL;
+}
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance, const char* pName)
+{
+    const EntryPoint* pEntryPoint = FindEntryPoint(pName);
+    return pEntryPoint ? pEntryPoint->pFunction : NULL;
+}
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice device, const char* pName)
+{
+    const EntryPoint* pEntryPoint = FindEntryPoint(pName);
+    return pEntryPoint ? pEntryPoint->pFunction : NULL;
+}
+
+} // namespace
+
+MOCK_ICD_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vk_icdNegotiateLoaderICDInterfaceVersion(uint32_t* pSupportedVersion)
+{
+    *pSupportedVersion = std::min(*pSupportedVersion, (uint32_t)MOCK_ICD_LOADER_INTERFACE_VERSION);
+    return VK_SUCCESS;
+}
+
+MOCK_ICD_EXPORT VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vk_icdGetInstanceProcAddr(VkInstance instance, const char* pName)
+{
+    return GetInstanceProcAddr(instance, pName);
+}
+
+MOCK_ICD_EXPORT VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vk_icdGetPhysicalDeviceProcAddr(VkInstance instance, const char* pName)
+{
+    const EntryPoint* pEntryPoint = FindEntryPoint(pName);
+    return (pEntryPoint && pEntryPoint->physicalDeviceCommand) ? pEntryPoint->pFunction : NULL;
+}
@@ -0,0 +1,255 @@
+#!/bin/bash
+# Build an LTO+PGO optimized vk-video-dec-test and compare it against the default build.
+#
+# Stages:
+#   1. default Release build                     (<build-root>/default)
+#   2. instrumented build, BUILD_PGO=GENERATE    (<build-root>/pgo)
+#   3. training: decode every bitstream with --np
+#   4. profile merge (llvm-profdata for Clang, GCC accumulates its .gcda files in place)
+#   5. optimized rebuild, BUILD_PGO=USE BUILD_LTO=ON in the same build directory as stage 2
+#   6. benchmark: decode the same bitstreams with the default and the optimized binaries and
+#      compare the per frame CPU (user+sys) and wall clock time. Every bitstream is decoded
+#      once with -c frames and once with -w frames; the difference between the two runs
+#      cancels the instance, device and shader setup out of the per frame numbers
+#
+# By default the decoder runs direct-to-display on the mock Vulkan Video driver built in
+# icd/, so neither a video capable GPU nor an X server is needed, and trains on synthetic
+# H.264/H.265 streams from scripts/generate_sample_bitstreams.py. With -d the decoder runs on
+# the system Vulkan driver instead, in an X window (the whole script runs under one xvfb-run
+# when no DISPLAY is set). Only the code compiled in this tree (libs/VkVideoParser, NvVkDecoder,
+# VulkanVideoFrameBuffer, VkShell and the demo itself) is instrumented. The prebuilt
+# nvidia-vkvideo-parser library and the system FFmpeg demuxer libraries are not.
+#
+# Usage: scripts/build_pgo.sh [-b build-root] [-c frames] [-w frames] [-r runs] [-j jobs] [-o cmake-option]... [-d] [bitstream|dir]...
+
+set -e
+
+if [[ $(uname) != "Linux" ]]; then
+    echo "$0 only supports Linux"
+    exit 1
+fi
+
+SCRIPT_ARGS=("$@")
+CURRENT_DIR="$(dirname "$(readlink -f "${BASH_SOURCE[0]}")")"
+CORE_COUNT=$(nproc || echo 4)
+SOURCE_DIR="$(dirname "$CURRENT_DIR")"
+BUILD_ROOT="$SOURCE_DIR/build-pgo"
+MAX_FRAMES=1000
+WARMUP_FRAMES=100
+BENCH_RUNS=5
+JOBS=$CORE_COUNT
+CMAKE_OPTIONS=()
+SYSTEM_DRIVER=0
+
+function usage () {
+   echo "Usage: $0 [-b build-root] [-c frames] [-w frames] [-r runs] [-j jobs] [-o cmake-option]... [-d] [bitstream|dir]..."
+   echo "  -b  root directory for the default and PGO build trees (default: $BUILD_ROOT)"
+   echo "  -c  max frames decoded per bitstream (default: $MAX_FRAMES)"
+   echo "  -w  frames of the short benchmark run subtracted from the full one (default: $WARMUP_FRAMES)"
+   echo "  -r  benchmark runs per bitstream and binary (default: $BENCH_RUNS)"
+   echo "  -j  parallel build jobs (default: $JOBS)"
+   echo "  -o  extra CMake option for all the builds, for example -o -DBUILD_WSI_WAYLAND_SUPPORT=OFF"
+   echo "  -d  decode on the system Vulkan driver in an X window instead of the mock driver"
+   echo "Without bitstreams, -c frames long samples are generated in <build-root>/bitstreams/<frames>."
+   exit 1
+}
+
+while getopts "b:c:w:r:j:o:dh" opt; do
+   case $opt in
+      b) BUILD_ROOT="$(readlink -f "$OPTARG")" ;;
+      c) MAX_FRAMES=$OPTARG ;;
+      w) WARMUP_FRAMES=$OPTARG ;;
+      r) BENCH_RUNS=$OPTARG ;;
+      j) JOBS=$OPTARG ;;
+      o) CMAKE_OPTIONS+=("$OPTARG") ;;
+      d) SYSTEM_DRIVER=1 ;;
+      *) usage ;;
+   esac
+done
+shift $((OPTIND - 1))
+
+# Share a single X server between all the decoder runs on the system driver
+if [ $SYSTEM_DRIVER -eq 1 ] && [ -z "$DISPLAY" ] && [ -z "$WAYLAND_DISPLAY" ]; then
+    if ! command -v xvfb-run > /dev/null; then
+        echo "Neither DISPLAY nor WAYLAND_DISPLAY are set and xvfb-run is not available."
+        exit 1
+    fi
+    exec xvfb-run -a "${BASH_SOURCE[0]}" "${SCRIPT_ARGS[@]}"
+fi
+
+BITSTREAMS=()
+for arg in "$@"; do
+   if [ -d "$arg" ]; then
+      while IFS= read -r -d '' f; do
+         BITSTREAMS+=("$f")
+      done < <(find "$arg" -type f \( -iname '*.264' -o -iname '*.h264' -o -iname '*.265' -o -iname '*.h265' \
+                                     -o -iname '*.hevc' -o -iname '*.mp4' -o -iname '*.mkv' -o -iname '*.mov' \) -print0 | sort -z)
+   elif [ -f "$arg" ]; then
+      BITSTREAMS+=("$arg")
+   else
+      echo "Bitstream $arg not found"
+      exit 1
+   fi
+done
+
+if [ "$WARMUP_FRAMES" -ge "$MAX_FRAMES" ]; then
+   echo "The -w frame count must be smaller than the -c frame count."
+   usage
+fi
+
+DEFAULT_BUILD="$BUILD_ROOT/default"
+PGO_BUILD="$BUILD_ROOT/pgo"
+PROFILE_DIR="$BUILD_ROOT/pgo-profiles"
+SAMPLES_DIR="$BUILD_ROOT/bitstreams/$MAX_FRAMES"
+DECODER=demos/vk-video-dec-test
+DECODER_ARGS=(--np --nt)
+
+if [ ${#BITSTREAMS[@]} -eq 0 ]; then
+   if [ ! -d "$SAMPLES_DIR" ]; then
+      echo "Generating $MAX_FRAMES frame training bitstreams in $SAMPLES_DIR"
+      python3 "$CURRENT_DIR/generate_sample_bitstreams.py" -n "$MAX_FRAMES" "$SAMPLES_DIR.tmp"
+      mv "$SAMPLES_DIR.tmp" "$SAMPLES_DIR"
+   fi
+   for f in "$SAMPLES_DIR"/*; do
+      BITSTREAMS+=("$f")
+   done
+fi
+
+if [ $SYSTEM_DRIVER -eq 0 ]; then
+   # The mock driver is built without LTO/PGO, every run uses the one from the default build
+   export VK_ICD_FILENAMES="$DEFAULT_BUILD/icd/VkVideoMockIcd.json"
+   DECODER_ARGS+=(--direct)
+fi
+
+function build () {
+   local build_dir=$1
+   shift
+   echo "Configuring $build_dir: $*"
+   cmake -S "$SOURCE_DIR" -B "$build_dir" -DCMAKE_BUILD_TYPE=Release -DBUILD_ICD=ON "${CMAKE_OPTIONS[@]}" "$@"
+   cmake --build "$build_dir" --parallel "$JOBS"
+}
+
+function decode () {
+   local build_dir=$1
+   local bitstream=$2
+   local frames=$3
+   if ! "$build_dir/$DECODER" -i "$bitstream" --c "$frames" "${DECODER_ARGS[@]}" > "$DECODE_LOG" 2>&1; then
+      echo "$build_dir/$DECODER failed on $bitstream:"
+      tail -n 20 "$DECODE_LOG"
+      exit 1
+   fi
+}
+
+# Decodes a bitstream and sets RUN_FRAMES to the frame count from the "frames:N, elapsedms:T"
+# stats line the decoder prints on exit, RUN_CPU_MS to the user+sys time and RUN_WALL_MS to
+# the real time of the decoder process
+function timed_decode () {
+   local TIMEFORMAT='%3U %3S %3R'
+   local times stats
+   { time decode "$@" ; } 2> "$TIME_LOG"
+   times=$(tail -n 1 "$TIME_LOG")
+   RUN_CPU_MS=$(echo "$times" | awk '{ printf "%.3f", ($1 + $2) * 1000 }')
+   RUN_WALL_MS=$(echo "$times" | awk '{ printf "%.3f", $3 * 1000 }')
+   stats=$(grep -o 'frames:[0-9]*, elapsedms:[0-9]*' "$DECODE_LOG" | tail -n 1)
+   if [ -z "$stats" ]; then
+      echo "No decoder stats found in the output for $2"
+      exit 1
+   fi
+   RUN_FRAMES=$(echo "$stats" | awk -F'[:,]' '{ print $2 }')
+}
+
+# Sets CPU_MS and WALL_MS to the per frame time of a bitstream, from the difference between
+# a MAX_FRAMES and a WARMUP_FRAMES decode
+function frame_ms () {
+   local build_dir=$1
+   local bitstream=$2
+   local frames cpu wall
+   timed_decode "$build_dir" "$bitstream" "$MAX_FRAMES"
+   frames=$RUN_FRAMES
+   cpu=$RUN_CPU_MS
+   wall=$RUN_WALL_MS
+   timed_decode "$build_dir" "$bitstream" "$WARMUP_FRAMES"
+   if [ "$frames" -le "$RUN_FRAMES" ]; then
+      echo "$bitstream has no more than $WARMUP_FRAMES frames, it cannot be benchmarked."
+      exit 1
+   fi
+   frames=$((frames - RUN_FRAMES))
+   CPU_MS=$(awk -v a="$cpu" -v b="$RUN_CPU_MS" -v n="$frames" 'BEGIN { printf "%.3f", (a - b) / n }')
+   WALL_MS=$(awk -v a="$wall" -v b="$RUN_WALL_MS" -v n="$frames" 'BEGIN { printf "%.3f", (a - b) / n }')
+}
+
+function min () {
+   awk -v a="$1" -v b="$2" 'BEGIN { print (a == "" || b < a) ? b : a }'
+}
+
+# Prints a benchmark line: name, default and optimized cpu ms/frame, default and optimized wall ms/frame
+function report () {
+   printf "%-40s %12.3f %12.3f %7.3fx %12.3f %12.3f %7.3fx\n" "$1" $2 $3 \
+          "$(awk -v a="$2" -v b="$3" 'BEGIN { print (b > 0) ? a / b : 0 }')" $4 $5 \
+          "$(awk -v a="$4" -v b="$5" 'BEGIN { print (b > 0) ? a / b : 0 }')"
+}
+
+DECODE_LOG=$(mktemp)
+TIME_LOG=$(mktemp)
+trap 'rm -f "$DECODE_LOG" "$TIME_LOG"' EXIT
+
+# Stage 1: default build
+build "$DEFAULT_BUILD" -DBUILD_PGO=OFF -DBUILD_LTO=OFF
+
+# Stage 2: instrumented build
+rm -rf "$PROFILE_DIR"
+build "$PGO_BUILD" -DBUILD_PGO=GENERATE -DBUILD_LTO=OFF -DPGO_PROFILE_DIR="$PROFILE_DIR"
+
+# Stage 3: training
+for bitstream in "${BITSTREAMS[@]}"; do
+   echo "Training with $bitstream"
+   decode "$PGO_BUILD" "$bitstream" "$MAX_FRAMES"
+done
+
+# Stage 4: profile merge
+if ls "$PROFILE_DIR"/*.profraw > /dev/null 2>&1; then
+   LLVM_PROFDATA=$(command -v llvm-profdata || true)
+   if [ -z "$LLVM_PROFDATA" ]; then
+      echo "llvm-profdata is required to merge the Clang training profiles."
+      exit 1
+   fi
+   "$LLVM_PROFDATA" merge -output="$PROFILE_DIR/vk-video-dec.profdata" "$PROFILE_DIR"/*.profraw
+elif [ -z "$(find "$PROFILE_DIR" -name '*.gcda' -print -quit)" ]; then
+   echo "The training run did not produce any profiles in $PROFILE_DIR."
+   exit 1
+fi
+
+# Stage 5: LTO+PGO rebuild
+build "$PGO_BUILD" -DBUILD_PGO=USE -DBUILD_LTO=ON -DPGO_PROFILE_DIR="$PROFILE_DIR"
+
+# Stage 6: benchmark, best of BENCH_RUNS per bitstream and binary
+echo
+printf "%-40s %12s %12s %8s %12s %12s %8s\n" "bitstream" "default" "lto+pgo" "" "default" "lto+pgo" ""
+printf "%-40s %12s %12s %8s %12s %12s %8s\n" "" "cpu(ms/f)" "cpu(ms/f)" "speedup" "wall(ms/f)" "wall(ms/f)" "speedup"
+total_cpu_default=0
+total_cpu_pgo=0
+total_wall_default=0
+total_wall_pgo=0
+for bitstream in "${BITSTREAMS[@]}"; do
+   cpu_default=
+   cpu_pgo=
+   wall_default=
+   wall_pgo=
+   for ((run = 0; run < BENCH_RUNS; run++)); do
+      frame_ms "$DEFAULT_BUILD" "$bitstream"
+      cpu_default=$(min "$cpu_default" "$CPU_MS")
+      wall_default=$(min "$wall_default" "$WALL_MS")
+      frame_ms "$PGO_BUILD" "$bitstream"
+      cpu_pgo=$(min "$cpu_pgo" "$CPU_MS")
+      wall_pgo=$(min "$wall_pgo" "$WALL_MS")
+   done
+   total_cpu_default=$(awk -v a="$total_cpu_default" -v b="$cpu_default" 'BEGIN { print a + b }')
+   total_cpu_pgo=$(awk -v a="$total_cpu_pgo" -v b="$cpu_pgo" 'BEGIN { print a + b }')
+   total_wall_default=$(awk -v a="$total_wall_default" -v b="$wall_default" 'BEGIN { print a + b }')
+   total_wall_pgo=$(awk -v a="$total_wall_pgo" -v b="$wall_pgo" 'BEGIN { print a + b }')
+   report "$(basename "$bitstream")" $cpu_default $cpu_pgo $wall_default $wall_pgo
+done
+report "total" $total_cpu_default $total_cpu_pgo $total_wall_default $total_wall_pgo
+
+echo
+echo "Optimized binary: $PGO_BUILD/$DECODER"
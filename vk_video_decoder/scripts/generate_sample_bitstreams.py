@@ -0,0 +1,735 @@
+#!/usr/bin/env python3
+#
+# Copyright 2021 NVIDIA Corporation.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Generate synthetic H.264 and H.265 elementary streams.
+
+The streams are used to train and benchmark the decoder on machines without
+sample content. They exercise the sequence and picture parameter sets, the
+slice headers, the reference picture management and the picture reordering
+of the decoder with IDR, P and non-reference B pictures.
+
+The picture content is deliberately simple: the IDR pictures are made of flat
+intra macroblocks (H.264 I_16x16 DC, H.265 intra DC without residual) and
+the P and B pictures of skipped macroblocks. Some of the macroblocks of every
+picture are I_PCM blocks so the access units have realistic sizes. H.264 is
+CAVLC coded, H.265 is CABAC coded.
+"""
+
+import argparse
+import os
+import sys
+
+
+class BitWriter(object):
+    def __init__(self):
+        self.data = bytearray()
+        self.cur = 0
+        self.nbits = 0
+
+    def u(self, n, value):
+        for i in range(n - 1, -1, -1):
+            self.cur = (self.cur << 1) | ((value >> i) & 1)
+            self.nbits += 1
+            if self.nbits == 8:
+                self.data.append(self.cur)
+                self.cur = 0
+                self.nbits = 0
+
+    def ue(self, value):
+        value += 1
+        length = value.bit_length()
+        self.u(length - 1, 0)
+        self.u(length, value)
+
+    def se(self, value):
+        self.ue(2 * value - 1 if value > 0 else -2 * value)
+
+    def aligned(self):
+        return self.nbits == 0
+
+    def align_zero(self):
+        if self.nbits:
+            self.u(8 - self.nbits, 0)
+
+    def trailing_bits(self):
+        self.u(1, 1)
+        self.align_zero()
+
+    def bytes(self, payload):
+        assert self.aligned()
+        self.data += payload
+
+
+def nal_unit(header, rbsp):
+    """Annex B NAL unit with start code and emulation prevention."""
+    out = bytearray(b"\x00\x00\x00\x01")
+    out += header
+    zeros = 0
+    for byte in rbsp:
+        if zeros >= 2 and byte <= 3:
+            out.append(3)
+            zeros = 0
+        out.append(byte)
+        zeros = zeros + 1 if byte == 0 else 0
+    return out
+
+
+def pcm_block(size, seed):
+    """8-bit 4:2:0 I_PCM samples of a size x size block, luma followed by Cb and Cr."""
+    luma = bytes(16 + ((x + y + seed) * 7) % 220 for y in range(size) for x in range(size))
+    chroma = bytes(16 + ((x * 3 + seed) % 220) for x in range((size // 2) * (size // 2)))
+    return luma + chroma + chroma
+
+
+def gop_structure(num_frames, gop_size, num_b_frames):
+    """List of (display index, type) in decode order, type is 'I', 'P' or 'B'."""
+    frames = []
+    for gop_start in range(0, num_frames, gop_size):
+        gop_end = min(gop_start + gop_size, num_frames)
+        frames.append((gop_start, 'I'))
+        prev_anchor = gop_start
+        while prev_anchor < gop_end - 1:
+            anchor = min(prev_anchor + num_b_frames + 1, gop_end - 1)
+            frames.append((anchor, 'P'))
+            for b in range(prev_anchor + 1, anchor):
+                frames.append((b, 'B'))
+            prev_anchor = anchor
+    return frames
+
+
+########################## H.264 ##########################
+
+class H264Writer(object):
+    # I_PCM macroblock every N macroblocks by slice type
+    PCM_PERIOD = {'I': 16, 'P': 128, 'B': 512}
+    LOG2_MAX_FRAME_NUM = 8
+    LOG2_MAX_POC_LSB = 8
+
+    def __init__(self, width, height, num_ref_frames):
+        self.width = width
+        self.height = height
+        self.mb_width = (width + 15) // 16
+        self.mb_height = (height + 15) // 16
+        self.num_ref_frames = num_ref_frames
+        self.level_idc = 51 if self.mb_width * self.mb_height > 8192 else 40
+
+    def sps(self):
+        bw = BitWriter()
+        bw.u(8, 77)                     # profile_idc: Main
+        bw.u(8, 0x40)                   # constraint_set1_flag
+        bw.u(8, self.level_idc)
+        bw.ue(0)                        # seq_parameter_set_id
+        bw.ue(self.LOG2_MAX_FRAME_NUM - 4)
+        bw.ue(0)                        # pic_order_cnt_type
+        bw.ue(self.LOG2_MAX_POC_LSB - 4)
+        bw.ue(self.num_ref_frames)
+        bw.u(1, 0)                      # gaps_in_frame_num_value_allowed_flag
+        bw.ue(self.mb_width - 1)
+        bw.ue(self.mb_height - 1)
+        bw.u(1, 1)                      # frame_mbs_only_flag
+        bw.u(1, 1)                      # direct_8x8_inference_flag
+        crop_right = (self.mb_width * 16 - self.width) // 2
+        crop_bottom = (self.mb_height * 16 - self.height) // 2
+        if crop_right or crop_bottom:
+            bw.u(1, 1)
+            bw.ue(0)
+            bw.ue(crop_right)
+            bw.ue(0)
+            bw.ue(crop_bottom)
+        else:
+            bw.u(1, 0)
+        bw.u(1, 0)                      # vui_parameters_present_flag
+        bw.trailing_bits()
+        return nal_unit(b"\x67", bw.data)
+
+    def pps(self):
+        bw = BitWriter()
+        bw.ue(0)                        # pic_parameter_set_id
+        bw.ue(0)                        # seq_parameter_set_id
+        bw.u(1, 0)                      # entropy_coding_mode_flag: CAVLC
+        bw.u(1, 0)                      # bottom_field_pic_order_in_frame_present_flag
+        bw.ue(0)                        # num_slice_groups_minus1
+        bw.ue(0)                        # num_ref_idx_l0_default_active_minus1
+        bw.ue(0)                        # num_ref_idx_l1_default_active_minus1
+        bw.u(1, 0)                      # weighted_pred_flag
+        bw.u(2, 0)                      # weighted_bipred_idc
+        bw.se(0)                        # pic_init_qp_minus26
+        bw.se(0)                        # pic_init_qs_minus26
+        bw.se(0)                        # chroma_qp_index_offset
+        bw.u(1, 1)                      # deblocking_filter_control_present_flag
+        bw.u(1, 0)                      # constrained_intra_pred_flag
+        bw.u(1, 0)                      # redundant_pic_cnt_present_flag
+        bw.trailing_bits()
+        return nal_unit(b"\x68", bw.data)
+
+    def slice(self, slice_type, frame_num, poc, idr_pic_id, seed):
+        is_ref = slice_type != 'B'
+        bw = BitWriter()
+        bw.ue(0)                        # first_mb_in_slice
+        bw.ue({'P': 5, 'B': 6, 'I': 7}[slice_type])
+        bw.ue(0)                        # pic_parameter_set_id
+        bw.u(self.LOG2_MAX_FRAME_NUM, frame_num % (1 << self.LOG2_MAX_FRAME_NUM))
+        if idr_pic_id is not None:
+            bw.ue(idr_pic_id)
+        bw.u(self.LOG2_MAX_POC_LSB, poc % (1 << self.LOG2_MAX_POC_LSB))
+        if slice_type == 'B':
+            bw.u(1, 1)                  # direct_spatial_mv_pred_flag
+        if slice_type != 'I':
+            bw.u(1, 0)                  # num_ref_idx_active_override_flag
+            bw.u(1, 0)                  # ref_pic_list_modification_flag_l0
+        if slice_type == 'B':
+            bw.u(1, 0)                  # ref_pic_list_modification_flag_l1
+        if is_ref:
+            if idr_pic_id is not None:
+                bw.u(1, 0)              # no_output_of_prior_pics_flag
+                bw.u(1, 0)              # long_term_reference_flag
+            else:
+                bw.u(1, 0)              # adaptive_ref_pic_marking_mode_flag
+        bw.se(0)                        # slice_qp_delta
+        bw.ue(1)                        # disable_deblocking_filter_idc
+
+        num_mbs = self.mb_width * self.mb_height
+        period = self.PCM_PERIOD[slice_type]
+        if slice_type == 'I':
+            # I_16x16 DC macroblocks without residual, the coeff_token of the
+            # Intra16x16DCLevel block depends on the I_PCM neighbours
+            total_coeff = [0] * num_mbs
+            for mb in range(num_mbs):
+                if (mb + seed) % period == 0:
+                    self._pcm_macroblock(bw, 25, mb, seed)
+                    total_coeff[mb] = 16
+                    continue
+                bw.ue(3)                # mb_type: I_16x16_2_0_0
+                bw.ue(0)                # intra_chroma_pred_mode: DC
+                bw.se(0)                # mb_qp_delta
+                mb_x = mb % self.mb_width
+                avail = []
+                if mb_x > 0:
+                    avail.append(total_coeff[mb - 1])
+                if mb >= self.mb_width:
+                    avail.append(total_coeff[mb - self.mb_width])
+                nc = (sum(avail) + 1) >> 1 if len(avail) == 2 else sum(avail)
+                if nc < 2:
+                    bw.u(1, 1)
+                elif nc < 4:
+                    bw.u(2, 3)
+                elif nc < 8:
+                    bw.u(4, 15)
+                else:
+                    bw.u(6, 3)
+        else:
+            # Skipped macroblocks, interrupted by intra I_PCM macroblocks
+            pcm_mb_type = 30 if slice_type == 'P' else 48
+            skip_run = 0
+            for mb in range(num_mbs):
+                if (mb + seed) % period == 0:
+                    bw.ue(skip_run)
+                    skip_run = 0
+                    self._pcm_macroblock(bw, pcm_mb_type, mb, seed)
+                else:
+                    skip_run += 1
+            if skip_run:
+                bw.ue(skip_run)
+        bw.trailing_bits()
+
+        if idr_pic_id is not None:
+            header = b"\x65"
+        elif is_ref:
+            header = b"\x41"
+        else:
+            header = b"\x01"
+        return nal_unit(header, bw.data)
+
+    @staticmethod
+    def _pcm_macroblock(bw, mb_type, mb, seed):
+        bw.ue(mb_type)
+        bw.align_zero()                 # pcm_alignment_zero_bit
+        bw.bytes(pcm_block(16, mb + seed))
+
+    def write(self, out, num_frames, gop_size, num_b_frames):
+        out.write(self.sps())
+        out.write(self.pps())
+        # frame_num is incremented after every reference picture, the B pictures that follow
+        # a P picture in decoding order share their frame_num with the next P picture
+        frame_num = 0
+        idr_pic_id = 0
+        gop_start = 0
+        for display_idx, slice_type in gop_structure(num_frames, gop_size, num_b_frames):
+            if slice_type == 'I':
+                gop_start = display_idx
+                out.write(self.slice('I', 0, 0, idr_pic_id, display_idx))
+                idr_pic_id ^= 1
+                frame_num = 1
+                continue
+            poc = 2 * (display_idx - gop_start)
+            out.write(self.slice(slice_type, frame_num, poc, None, display_idx))
+            if slice_type == 'P':
+                frame_num += 1
+
+
+########################## H.265 ##########################
+
+RANGE_TAB_LPS = [
+    [128, 176, 208, 240], [128, 167, 197, 227], [128, 158, 187, 216], [123, 150, 178, 205],
+    [116, 142, 169, 195], [111, 135, 160, 185], [105, 128, 152, 175], [100, 122, 144, 166],
+    [95, 116, 137, 158], [90, 110, 130, 150], [85, 104, 123, 142], [81, 99, 117, 135],
+    [77, 94, 111, 128], [73, 89, 105, 122], [69, 85, 100, 116], [66, 80, 95, 110],
+    [62, 76, 90, 104], [59, 72, 86, 99], [56, 69, 81, 94], [53, 65, 77, 89],
+    [51, 62, 73, 85], [48, 59, 69, 80], [46, 56, 66, 76], [43, 53, 63, 72],
+    [41, 50, 59, 69], [39, 48, 56, 65], [37, 45, 54, 62], [35, 43, 51, 59],
+    [33, 41, 48, 56], [32, 39, 46, 53], [30, 37, 43, 50], [29, 35, 41, 48],
+    [27, 33, 39, 45], [26, 31, 37, 43], [24, 30, 35, 41], [23, 28, 33, 39],
+    [22, 27, 32, 37], [21, 26, 30, 35], [20, 24, 29, 33], [19, 23, 27, 31],
+    [18, 22, 26, 30], [17, 21, 25, 28], [16, 20, 23, 27], [15, 19, 22, 25],
+    [14, 18, 21, 24], [14, 17, 20, 23], [13, 16, 19, 22], [12, 15, 18, 21],
+    [12, 14, 17, 20], [11, 14, 16, 19], [11, 13, 15, 18], [10, 12, 15, 17],
+    [10, 12, 14, 16], [9, 11, 13, 15], [9, 11, 12, 14], [8, 10, 12, 14],
+    [8, 9, 11, 13], [7, 9, 11, 12], [7, 9, 10, 12], [7, 8, 10, 11],
+    [6, 8, 9, 11], [6, 7, 9, 10], [6, 7, 8, 9], [2, 2, 2, 2],
+]
+
+TRANS_IDX_LPS = [
+    0, 0, 1, 2, 2, 4, 4, 5, 6, 7, 8, 9, 9, 11, 11, 12,
+    13, 13, 15, 15, 16, 16, 18, 18, 19, 19, 21, 21, 22, 22, 23, 24,
+    24, 25, 26, 26, 27, 27, 28, 29, 29, 30, 30, 30, 31, 32, 32, 33,
+    33, 33, 34, 34, 35, 35, 35, 36, 36, 36, 37, 37, 37, 38, 38, 63,
+]
+
+
+class CabacWriter(object):
+    """H.265 arithmetic encoder, 9.3.4.3 of the specification run in reverse."""
+
+    def __init__(self, bw):
+        self.bw = bw
+        self.start()
+
+    def start(self):
+        self.low = 0
+        self.range = 510
+        self.first_bit = True
+        self.outstanding = 0
+
+    @staticmethod
+    def context(init_value, qp):
+        slope = (init_value >> 4) * 5 - 45
+        offset = ((init_value & 15) << 3) - 16
+        state = min(max(((slope * min(max(qp, 0), 51)) >> 4) + offset, 1), 126)
+        if state <= 63:
+            return [63 - state, 0]
+        return [state - 64, 1]
+
+    def _put_bit(self, bit):
+        if self.first_bit:
+            self.first_bit = False
+        else:
+            self.bw.u(1, bit)
+        while self.outstanding:
+            self.bw.u(1, 1 - bit)
+            self.outstanding -= 1
+
+    def _renorm(self):
+        while self.range < 256:
+            if self.low < 256:
+                self._put_bit(0)
+            elif self.low >= 512:
+                self.low -= 512
+                self._put_bit(1)
+            else:
+                self.low -= 256
+                self.outstanding += 1
+            self.range <<= 1
+            self.low <<= 1
+
+    def decision(self, ctx, bin_val):
+        state, mps = ctx
+        lps_range = RANGE_TAB_LPS[state][(self.range >> 6) & 3]
+        self.range -= lps_range
+        if bin_val != mps:
+            self.low += self.range
+            self.range = lps_range
+            if state == 0:
+                ctx[1] = 1 - mps
+            ctx[0] = TRANS_IDX_LPS[state]
+        else:
+            ctx[0] = min(state + 1, 62)
+        self._renorm()
+
+    def bypass(self, bin_val):
+        self.low <<= 1
+        if bin_val:
+            self.low += self.range
+        if self.low >= 1024:
+            self._put_bit(1)
+            self.low -= 1024
+        elif self.low < 512:
+            self._put_bit(0)
+        else:
+            self.low -= 512
+            self.outstanding += 1
+
+    def terminate(self, bin_val):
+        self.range -= 2
+        if bin_val:
+            self.low += self.range
+            # Flush, the last bit written is the rbsp_stop_one_bit of the slice
+            # or the bit preceding the pcm_alignment_zero_bits
+            self.range = 2
+            self._renorm()
+            self._put_bit((self.low >> 9) & 1)
+            self.bw.u(2, ((self.low >> 7) & 3) | 1)
+        else:
+            self._renorm()
+
+
+class H265Writer(object):
+    # PCM coding unit every N coding units by slice type
+    PCM_PERIOD = {'I': 16, 'P': 64, 'B': 256}
+    LOG2_MAX_POC_LSB = 8
+    LOG2_MIN_CB = 3
+    LOG2_CTB = 5
+    SLICE_QP = 26
+
+    # Context initialization values, initType 0 (I), 1 (P) and 2 (B)
+    INIT_SPLIT_CU_FLAG = [[139, 141, 157], [107, 139, 126], [107, 139, 126]]
+    INIT_CU_SKIP_FLAG = [None, [197, 185, 201], [197, 185, 201]]
+    INIT_PRED_MODE_FLAG = [None, 149, 134]
+    INIT_PART_MODE = [184, 154, 154]
+    INIT_PREV_INTRA_LUMA_PRED_FLAG = [184, 154, 183]
+    INIT_INTRA_CHROMA_PRED_MODE = [63, 152, 152]
+    INIT_CBF_LUMA = [[111, 141], [153, 111], [153, 111]]
+    INIT_CBF_CHROMA = [94, 149, 149]
+
+    def __init__(self, width, height, num_b_frames):
+        assert width % 8 == 0 and height % 8 == 0
+        self.width = width
+        self.height = height
+        self.num_b_frames = num_b_frames
+        self.level_idc = 153 if width * height > 2228224 else 120
+        self.min_cb_width = width >> self.LOG2_MIN_CB
+        self.min_cb_height = height >> self.LOG2_MIN_CB
+
+    @staticmethod
+    def nal_header(nal_type):
+        return bytes([nal_type << 1, 1])
+
+    def profile_tier_level(self, bw):
+        bw.u(2, 0)                      # general_profile_space
+        bw.u(1, 0)                      # general_tier_flag
+        bw.u(5, 1)                      # general_profile_idc: Main
+        bw.u(32, 0x60000000)            # general_profile_compatibility_flag[1] and [2]
+        bw.u(1, 1)                      # general_progressive_source_flag
+        bw.u(1, 0)                      # general_interlaced_source_flag
+        bw.u(1, 0)                      # general_non_packed_constraint_flag
+        bw.u(1, 1)                      # general_frame_only_constraint_flag
+        bw.u(32, 0)                     # general_reserved_zero_43bits
+        bw.u(11, 0)
+        bw.u(1, 0)                      # general_reserved_zero_bit
+        bw.u(8, self.level_idc)
+
+    def max_dec_pic_buffering(self):
+        # Two reference pictures, the pictures waiting for output and the current picture
+        return 5
+
+    def vps(self):
+        bw = BitWriter()
+        bw.u(4, 0)                      # vps_video_parameter_set_id
+        bw.u(1, 1)                      # vps_base_layer_internal_flag
+        bw.u(1, 1)                      # vps_base_layer_available_flag
+        bw.u(6, 0)                      # vps_max_layers_minus1
+        bw.u(3, 0)                      # vps_max_sub_layers_minus1
+        bw.u(1, 1)                      # vps_temporal_id_nesting_flag
+        bw.u(16, 0xffff)                # vps_reserved_0xffff_16bits
+        self.profile_tier_level(bw)
+        bw.u(1, 1)                      # vps_sub_layer_ordering_info_present_flag
+        bw.ue(self.max_dec_pic_buffering() - 1)
+        bw.ue(1 if self.num_b_frames else 0)
+        bw.ue(0)                        # vps_max_latency_increase_plus1
+        bw.u(6, 0)                      # vps_max_layer_id
+        bw.ue(0)                        # vps_num_layer_sets_minus1
+        bw.u(1, 0)                      # vps_timing_info_present_flag
+        bw.u(1, 0)                      # vps_extension_flag
+        bw.trailing_bits()
+        return nal_unit(self.nal_header(32), bw.data)
+
+    def sps(self):
+        bw = BitWriter()
+        bw.u(4, 0)                      # sps_video_parameter_set_id
+        bw.u(3, 0)                      # sps_max_sub_layers_minus1
+        bw.u(1, 1)                      # sps_temporal_id_nesting_flag
+        self.profile_tier_level(bw)
+        bw.ue(0)                        # sps_seq_parameter_set_id
+        bw.ue(1)                        # chroma_format_idc: 4:2:0
+        bw.ue(self.width)
+        bw.ue(self.height)
+        bw.u(1, 0)                      # conformance_window_flag
+        bw.ue(0)                        # bit_depth_luma_minus8
+        bw.ue(0)                        # bit_depth_chroma_minus8
+        bw.ue(self.LOG2_MAX_POC_LSB - 4)
+        bw.u(1, 1)                      # sps_sub_layer_ordering_info_present_flag
+        bw.ue(self.max_dec_pic_buffering() - 1)
+        bw.ue(1 if self.num_b_frames else 0)
+        bw.ue(0)                        # sps_max_latency_increase_plus1
+        bw.ue(self.LOG2_MIN_CB - 3)
+        bw.ue(self.LOG2_CTB - self.LOG2_MIN_CB)
+        bw.ue(0)                        # log2_min_luma_transform_block_size_minus2
+        bw.ue(3)                        # log2_diff_max_min_luma_transform_block_size
+        bw.ue(0)                        # max_transform_hierarchy_depth_inter
+        bw.ue(0)                        # max_transform_hierarchy_depth_intra
+        bw.u(1, 0)                      # scaling_list_enabled_flag
+        bw.u(1, 0)                      # amp_enabled_flag
+        bw.u(1, 0)                      # sample_adaptive_offset_enabled_flag
+        bw.u(1, 1)                      # pcm_enabled_flag
+        bw.u(4, 7)                      # pcm_sample_bit_depth_luma_minus1
+        bw.u(4, 7)                      # pcm_sample_bit_depth_chroma_minus1
+        bw.ue(self.LOG2_MIN_CB - 3)     # log2_min_pcm_luma_coding_block_size_minus3
+        bw.ue(self.LOG2_CTB - self.LOG2_MIN_CB)
+        bw.u(1, 1)                      # pcm_loop_filter_disabled_flag
+        bw.ue(0)                        # num_short_term_ref_pic_sets
+        bw.u(1, 0)                      # long_term_ref_pics_present_flag
+        bw.u(1, 0)                      # sps_temporal_mvp_enabled_flag
+        bw.u(1, 0)                      # strong_intra_smoothing_enabled_flag
+        bw.u(1, 0)                      # vui_parameters_present_flag
+        bw.u(1, 0)                      # sps_extension_present_flag
+        bw.trailing_bits()
+        return nal_unit(self.nal_header(33), bw.data)
+
+    def pps(self):
+        bw = BitWriter()
+        bw.ue(0)                        # pps_pic_parameter_set_id
+        bw.ue(0)                        # pps_seq_parameter_set_id
+        bw.u(1, 0)                      # dependent_slice_segments_enabled_flag
+        bw.u(1, 0)                      # output_flag_present_flag
+        bw.u(3, 0)                      # num_extra_slice_header_bits
+        bw.u(1, 0)                      # sign_data_hiding_enabled_flag
+        bw.u(1, 0)                      # cabac_init_present_flag
+        bw.ue(0)                        # num_ref_idx_l0_default_active_minus1
+        bw.ue(0)                        # num_ref_idx_l1_default_active_minus1
+        bw.se(self.SLICE_QP - 26)       # init_qp_minus26
+        bw.u(1, 0)                      # constrained_intra_pred_flag
+        bw.u(1, 0)                      # transform_skip_enabled_flag
+        bw.u(1, 0)                      # cu_qp_delta_enabled_flag
+        bw.se(0)                        # pps_cb_qp_offset
+        bw.se(0)                        # pps_cr_qp_offset
+        bw.u(1, 0)                      # pps_slice_chroma_qp_offsets_present_flag
+        bw.u(1, 0)                      # weighted_pred_flag
+        bw.u(1, 0)                      # weighted_bipred_flag
+        bw.u(1, 0)                      # transquant_bypass_enabled_flag
+        bw.u(1, 0)                      # tiles_enabled_flag
+        bw.u(1, 0)                      # entropy_coding_sync_enabled_flag
+        bw.u(1, 0)                      # pps_loop_filter_across_slices_enabled_flag
+        bw.u(1, 1)                      # deblocking_filter_control_present_flag
+        bw.u(1, 0)                      # deblocking_filter_override_enabled_flag
+        bw.u(1, 1)                      # pps_deblocking_filter_disabled_flag
+        bw.u(1, 0)                      # pps_scaling_list_data_present_flag
+        bw.u(1, 0)                      # lists_modification_present_flag
+        bw.ue(0)                        # log2_parallel_merge_level_minus2
+        bw.u(1, 0)                      # slice_segment_header_extension_present_flag
+        bw.u(1, 0)                      # pps_extension_present_flag
+        bw.trailing_bits()
+        return nal_unit(self.nal_header(34), bw.data)
+
+    def slice(self, slice_type, poc, negative_refs, positive_refs, seed):
+        init_type = {'I': 0, 'P': 1, 'B': 2}[slice_type]
+        if slice_type == 'I':
+            nal_type = 20               # IDR_N_LP
+        elif slice_type == 'P':
+            nal_type = 1                # TRAIL_R
+        else:
+            nal_type = 0                # TRAIL_N
+
+        bw = BitWriter()
+        bw.u(1, 1)                      # first_slice_segment_in_pic_flag
+        if slice_type == 'I':
+            bw.u(1, 0)                  # no_output_of_prior_pics_flag
+        bw.ue(0)                        # slice_pic_parameter_set_id
+        bw.ue({'B': 0, 'P': 1, 'I': 2}[slice_type])
+        if slice_type != 'I':
+            bw.u(self.LOG2_MAX_POC_LSB, poc % (1 << self.LOG2_MAX_POC_LSB))
+            bw.u(1, 0)                  # short_term_ref_pic_set_sps_flag
+            # st_ref_pic_set(0)
+            bw.ue(len(negative_refs))
+            bw.ue(len(positive_refs))
+            prev = poc
+            for ref in negative_refs:
+                bw.ue(prev - ref - 1)   # delta_poc_s0_minus1
+                bw.u(1, 1)              # used_by_curr_pic_s0_flag
+                prev = ref
+            prev = poc
+            for ref in positive_refs:
+                bw.ue(ref - prev - 1)   # delta_poc_s1_minus1
+                bw.u(1, 1)              # used_by_curr_pic_s1_flag
+                prev = ref
+            bw.u(1, 0)                  # num_ref_idx_active_override_flag
+            if slice_type == 'B':
+                bw.u(1, 0)              # mvd_l1_zero_flag
+            bw.ue(4)                    # five_minus_max_num_merge_cand
+        bw.se(0)                        # slice_qp_delta
+        bw.trailing_bits()              # byte_alignment()
+
+        self.slice_type = slice_type
+        self.seed = seed
+        self.cu_count = 0
+        self.cabac = CabacWriter(bw)
+        qp = self.SLICE_QP
+        ctx = CabacWriter.context
+        self.ctx_split = [ctx(v, qp) for v in self.INIT_SPLIT_CU_FLAG[init_type]]
+        if slice_type != 'I':
+            self.ctx_skip = [ctx(v, qp) for v in self.INIT_CU_SKIP_FLAG[init_type]]
+            self.ctx_pred_mode = ctx(self.INIT_PRED_MODE_FLAG[init_type], qp)
+        self.ctx_part_mode = ctx(self.INIT_PART_MODE[init_type], qp)
+        self.ctx_prev_intra = ctx(self.INIT_PREV_INTRA_LUMA_PRED_FLAG[init_type], qp)
+        self.ctx_chroma_mode = ctx(self.INIT_INTRA_CHROMA_PRED_MODE[init_type], qp)
+        self.ctx_cbf_luma = [ctx(v, qp) for v in self.INIT_CBF_LUMA[init_type]]
+        self.ctx_cbf_chroma = ctx(self.INIT_CBF_CHROMA[init_type], qp)
+        self.depth = bytearray(self.min_cb_width * self.min_cb_height)
+        self.skip = bytearray(self.min_cb_width * self.min_cb_height)
+
+        ctb_size = 1 << self.LOG2_CTB
+        ctb_width = (self.width + ctb_size - 1) // ctb_size
+        ctb_height = (self.height + ctb_size - 1) // ctb_size
+        for ctb in range(ctb_width * ctb_height):
+            self.coding_quadtree((ctb % ctb_width) * ctb_size, (ctb // ctb_width) * ctb_size, self.LOG2_CTB, 0)
+            self.cabac.terminate(1 if ctb == ctb_width * ctb_height - 1 else 0)  # end_of_slice_segment_flag
+        bw.align_zero()                 # rbsp_slice_segment_trailing_bits
+        return nal_unit(self.nal_header(nal_type), bw.data)
+
+    def coding_quadtree(self, x0, y0, log2_size, depth):
+        size = 1 << log2_size
+        if x0 + size <= self.width and y0 + size <= self.height and log2_size > self.LOG2_MIN_CB:
+            ctx_inc = 0
+            if x0 > 0 and self.depth[self._cb(x0 - 1, y0)] > depth:
+                ctx_inc += 1
+            if y0 > 0 and self.depth[self._cb(x0, y0 - 1)] > depth:
+                ctx_inc += 1
+            self.cabac.decision(self.ctx_split[ctx_inc], 0)
+            split = False
+        else:
+            split = log2_size > self.LOG2_MIN_CB
+        if split:
+            half = size >> 1
+            for y in (y0, y0 + half):
+                for x in (x0, x0 + half):
+                    if x < self.width and y < self.height:
+                        self.coding_quadtree(x, y, log2_size - 1, depth + 1)
+        else:
+            self.coding_unit(x0, y0, log2_size, depth)
+
+    def _cb(self, x, y):
+        return (y >> self.LOG2_MIN_CB) * self.min_cb_width + (x >> self.LOG2_MIN_CB)
+
+    def coding_unit(self, x0, y0, log2_size, depth):
+        cabac = self.cabac
+        size = 1 << log2_size
+        pcm = (self.cu_count + self.seed) % self.PCM_PERIOD[self.slice_type] == 0
+        self.cu_count += 1
+        skip = self.slice_type != 'I' and not pcm
+
+        if self.slice_type != 'I':
+            ctx_inc = 0
+            if x0 > 0 and self.skip[self._cb(x0 - 1, y0)]:
+                ctx_inc += 1
+            if y0 > 0 and self.skip[self._cb(x0, y0 - 1)]:
+                ctx_inc += 1
+            cabac.decision(self.ctx_skip[ctx_inc], 1 if skip else 0)  # cu_skip_flag
+
+        for y in range(y0, y0 + size, 1 << self.LOG2_MIN_CB):
+            for x in range(x0, x0 + size, 1 << self.LOG2_MIN_CB):
+                self.depth[self._cb(x, y)] = depth
+                self.skip[self._cb(x, y)] = 1 if skip else 0
+
+        if skip:
+            # prediction_unit: merge_idx is not present with MaxNumMergeCand 1
+            return
+
+        if self.slice_type != 'I':
+            cabac.decision(self.ctx_pred_mode, 1)  # pred_mode_flag: MODE_INTRA
+        if log2_size == self.LOG2_MIN_CB:
+            cabac.decision(self.ctx_part_mode, 1)  # part_mode: PART_2Nx2N
+        if pcm:
+            cabac.terminate(1)          # pcm_flag
+            cabac.bw.align_zero()       # pcm_alignment_zero_bit
+            cabac.bw.bytes(pcm_block(size, self.cu_count + self.seed))
+            cabac.start()
+            return
+        cabac.terminate(0)              # pcm_flag
+        # INTRA_DC is the second most probable mode, all the neighbours are DC, PCM or unavailable
+        cabac.decision(self.ctx_prev_intra, 1)  # prev_intra_luma_pred_flag
+        cabac.bypass(1)                 # mpm_idx 1
+        cabac.bypass(0)
+        cabac.decision(self.ctx_chroma_mode, 0)  # intra_chroma_pred_mode 4
+        cabac.decision(self.ctx_cbf_chroma, 0)  # cbf_cb
+        cabac.decision(self.ctx_cbf_chroma, 0)  # cbf_cr
+        cabac.decision(self.ctx_cbf_luma[1], 0)  # cbf_luma
+
+    def write(self, out, num_frames, gop_size, num_b_frames):
+        out.write(self.vps())
+        out.write(self.sps())
+        out.write(self.pps())
+        gop_start = 0
+        anchors = []
+        for display_idx, slice_type in gop_structure(num_frames, gop_size, num_b_frames):
+            poc = display_idx - gop_start
+            if slice_type == 'I':
+                gop_start = display_idx
+                anchors = [0]
+                out.write(self.slice('I', 0, [], [], display_idx))
+            elif slice_type == 'P':
+                # Keep the last two anchor pictures
+                out.write(self.slice('P', poc, anchors[::-1], [], display_idx))
+                anchors = (anchors + [poc])[-2:]
+            else:
+                out.write(self.slice('B', poc, [a for a in anchors[::-1] if a < poc],
+                                     [a for a in anchors if a > poc], display_idx))
+
+
+########################## Main ##########################
+
+# name, codec, width, height, frames, gop size, B frames, reference frames
+SAMPLES = [
+    ("h264_1920x1080_ibbp.264", "h264", 1920, 1080, 300, 30, 2, 4),
+    ("h264_1280x720_ippp.264", "h264", 1280, 720, 300, 60, 0, 4),
+    ("h265_1920x1080_ibbp.265", "h265", 1920, 1080, 300, 30, 2, 2),
+    ("h265_1280x720_ippp.265", "h265", 1280, 720, 300, 60, 0, 2),
+]
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("output_dir", help="directory the bitstreams are written to")
+    parser.add_argument("-n", "--frames", type=int, help="override the number of frames of every bitstream")
+    args = parser.parse_args(argv)
+
+    if not os.path.isdir(args.output_dir):
+        os.makedirs(args.output_dir)
+
+    for name, codec, width, height, frames, gop_size, num_b_frames, num_refs in SAMPLES:
+        if args.frames:
+            frames = args.frames
+        if codec == "h264":
+            writer = H264Writer(width, height, num_refs)
+        else:
+            writer = H265Writer(width, height, num_b_frames)
+        path = os.path.join(args.output_dir, name)
+        with open(path, "wb") as out:
+            writer.write(out, frames, gop_size, num_b_frames)
+        print("%s: %d frames %dx%d" % (path, frames, width, height))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))